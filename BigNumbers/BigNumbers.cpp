@@ -10,12 +10,278 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <system_error>
 #include <vector>
 #include <algorithm>
 #include <memory>
 #include <functional>
 #include <compare>
 #include <stdexcept>
+#include <utility>
+#include <bit>
+#include <deque>
+#include <mutex>
+#include <iterator>
+#include <concepts>
+#include <initializer_list>
+#include <chrono>
+#include <random>
+#include <array>
+#include <atomic>
+#include <future>
+#include <span>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define CBIGINT_AVX2_KERNELS
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Growable array of 32-bit limbs with inline storage for small values.
+ *
+ * Up to INLINE_CAPACITY limbs (128 bits) live inside the object itself, only larger values allocate
+ * a heap buffer. The interface mirrors the subset of std::vector used by CBigInt.
+ */
+class CLimbVector {
+public:
+//	--------------------------------------------------------------------------------------------------------------------
+
+	using value_type = uint32_t;
+	using iterator = value_type*;
+	using const_iterator = const value_type*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	static constexpr const size_t INLINE_CAPACITY = 4;
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	CLimbVector() : size_(0), capacity_(INLINE_CAPACITY), storage_() {}
+
+	explicit CLimbVector(size_t count, value_type value = 0) : CLimbVector() {
+		assign(count, value);
+	}
+
+	CLimbVector(std::initializer_list<value_type> values) : CLimbVector() {
+		assign(values.begin(), values.end());
+	}
+
+	template<std::forward_iterator It>
+	CLimbVector(It first, It last) : CLimbVector() {
+		assign(first, last);
+	}
+
+	CLimbVector(const CLimbVector& src) : CLimbVector() {
+		assign(src.begin(), src.end());
+	}
+
+	CLimbVector(CLimbVector&& src) noexcept : CLimbVector() {
+		swap(src);
+	}
+
+	~CLimbVector() {
+		if (!isInline_())
+			delete[] storage_.heap;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Copy assignment, reusing the existing buffer when it is large enough.
+	 *
+	 * @param src The limbs to copy.
+	 * @return A reference to this object.
+	 */
+	CLimbVector& operator=(const CLimbVector& src) {
+		if (this != &src)
+			assign(src.begin(), src.end());
+
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment, the buffers are exchanged.
+	 *
+	 * @param src The limbs to move from.
+	 * @return A reference to this object.
+	 */
+	CLimbVector& operator=(CLimbVector&& src) noexcept {
+		if (this != &src)
+			swap(src);
+
+		return *this;
+	}
+
+	friend bool operator==(const CLimbVector& x, const CLimbVector& y) {
+		return std::equal(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	[[nodiscard]] size_t size() const {
+		return size_;
+	}
+
+	[[nodiscard]] size_t capacity() const {
+		return capacity_;
+	}
+
+	[[nodiscard]] bool empty() const {
+		return size_ == 0;
+	}
+
+	[[nodiscard]] value_type* data() {
+		return isInline_() ? storage_.limbs : storage_.heap;
+	}
+
+	[[nodiscard]] const value_type* data() const {
+		return isInline_() ? storage_.limbs : storage_.heap;
+	}
+
+	value_type& operator[](size_t index) {
+		return data()[index];
+	}
+
+	const value_type& operator[](size_t index) const {
+		return data()[index];
+	}
+
+	[[nodiscard]] value_type& back() {
+		return data()[size_ - 1];
+	}
+
+	[[nodiscard]] const value_type& back() const {
+		return data()[size_ - 1];
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	iterator begin() { return data(); }
+	iterator end() { return data() + size_; }
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + size_; }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Make room for at least the given number of limbs, growing geometrically.
+	 *
+	 * @param capacity The requested capacity.
+	 */
+	void reserve(size_t capacity) {
+		if (capacity <= capacity_)
+			return;
+
+		size_t new_capacity = std::max(capacity, capacity_ * 2);
+		auto new_data = new value_type[new_capacity];
+		std::copy(begin(), end(), new_data);
+
+		if (!isInline_())
+			delete[] storage_.heap;
+		storage_.heap = new_data;
+		capacity_ = new_capacity;
+	}
+
+	void resize(size_t count, value_type value = 0) {
+		reserve(count);
+		if (count > size_)
+			std::fill(data() + size_, data() + count, value);
+		size_ = count;
+	}
+
+	void assign(size_t count, value_type value) {
+		size_ = 0;
+		resize(count, value);
+	}
+
+	template<std::forward_iterator It>
+	void assign(It first, It last) {
+		size_t count = static_cast<size_t>(std::distance(first, last));
+		size_ = 0;
+		reserve(count);
+		std::copy(first, last, data());
+		size_ = count;
+	}
+
+	void push_back(value_type value) {
+		if (size_ == capacity_)
+			reserve(size_ + 1);
+		data()[size_++] = value;
+	}
+
+	void pop_back() {
+		--size_;
+	}
+
+	void clear() {
+		size_ = 0;
+	}
+
+	iterator insert(const_iterator pos, size_t count, value_type value) {
+		size_t index = static_cast<size_t>(pos - begin());
+		resize(size_ + count);
+		std::copy_backward(begin() + index, end() - count, end());
+		std::fill(begin() + index, begin() + index + count, value);
+
+		return begin() + index;
+	}
+
+	template<std::forward_iterator It>
+	iterator insert(const_iterator pos, It first, It last) {
+		size_t index = static_cast<size_t>(pos - begin()), count = static_cast<size_t>(std::distance(first, last));
+		resize(size_ + count);
+		std::copy_backward(begin() + index, end() - count, end());
+		std::copy(first, last, begin() + index);
+
+		return begin() + index;
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {
+		size_t index = static_cast<size_t>(first - begin()), count = static_cast<size_t>(last - first);
+		std::copy(begin() + index + count, end(), begin() + index);
+		size_ -= count;
+
+		return begin() + index;
+	}
+
+	void swap(CLimbVector& other) noexcept {
+		std::swap(size_, other.size_);
+		std::swap(capacity_, other.capacity_);
+		std::swap(storage_, other.storage_);
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+private:
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Either the inline limbs or the pointer to the heap buffer, selected by the capacity.
+	 */
+	union CStorage {
+		value_type* heap;
+		value_type limbs[INLINE_CAPACITY];
+	};
+
+	size_t size_, capacity_;
+	CStorage storage_;
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	[[nodiscard]] bool isInline_() const {
+		return capacity_ == INLINE_CAPACITY;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+};
 
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
@@ -25,7 +291,11 @@
  *
  * The CBigInt class allows for the representation and manipulation of large integers that exceed
  * the standard data type limits. It supports various operations such as addition, multiplication,
- * and comparisons.
+ * division, modular exponentiation and comparisons.
+ *
+ * The magnitude is stored as little-endian binary limbs (base 2^32), the sign is kept separately.
+ * Large operands switch to Karatsuba multiplication and Newton reciprocal division, which in turn
+ * make the divide-and-conquer decimal conversion subquadratic.
  */
 class CBigInt {
 public:
@@ -37,66 +307,145 @@ public:
 	enum class CBigIntSign {NEGATIVE, ZERO, POSITIVE};
 
 	/**
-	 * @brief Typedef for the digits of the big integer.
+	 * @brief Typedef for the digits (binary limbs) of the big integer.
+	 */
+	using CBigIntDigit = uint32_t;
+
+	/**
+	 * @brief Typedef for the double-width intermediate used by limb arithmetic.
+	 */
+	using CBigIntWideDigit = uint64_t;
+
+	/**
+	 * @brief Typedef for the limb storage, values up to 128 bits do not allocate.
+	 */
+	using CBigIntLimbs = CLimbVector;
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Tag base of the lazy expression types produced by CBigInt arithmetic.
+	 *
+	 * Expressions only keep references to their operands, they must be converted to CBigInt before
+	 * the end of the full expression that created them (do not store them in auto variables).
+	 */
+	class CBigIntExpression {};
+
+	/**
+	 * @brief Lazy single CBigInt operand of a sum.
 	 */
-	using CBigIntDigit = int;
+	class CBigIntTerm : public CBigIntExpression {
+	public:
+		explicit CBigIntTerm(const CBigInt& x) : x_(x) {}
+
+		operator CBigInt() const {
+			return x_;
+		}
+
+		template<typename F>
+		void forEachTerm(F&& visit) const {
+			visit(x_, nullptr);
+		}
+
+		[[nodiscard]] size_t maxTermSize() const {
+			return x_.digits_.size();
+		}
+
+	private:
+		const CBigInt& x_;
+	};
+
+	/**
+	 * @brief Lazy product of two CBigInt objects.
+	 */
+	class CBigIntProduct : public CBigIntExpression {
+	public:
+		CBigIntProduct(const CBigInt& x, const CBigInt& y) : x_(x), y_(y) {}
+
+		operator CBigInt() const {
+			return multiply_(x_, y_);
+		}
+
+		template<typename F>
+		void forEachTerm(F&& visit) const {
+			visit(x_, &y_);
+		}
+
+		[[nodiscard]] size_t maxTermSize() const {
+			return x_.digits_.size() + y_.digits_.size();
+		}
+
+	private:
+		const CBigInt &x_, &y_;
+	};
+
+	/**
+	 * @brief Lazy sum of two expressions, evaluated by accumulating all terms into one buffer.
+	 */
+	template<typename L, typename R>
+	class CBigIntSum : public CBigIntExpression {
+	public:
+		CBigIntSum(const L& left, const R& right) : left_(left), right_(right) {}
+
+		operator CBigInt() const {
+			return evaluate_(*this);
+		}
+
+		template<typename F>
+		void forEachTerm(F&& visit) const {
+			left_.forEachTerm(visit);
+			right_.forEachTerm(visit);
+		}
+
+		[[nodiscard]] size_t maxTermSize() const {
+			return std::max(left_.maxTermSize(), right_.maxTermSize());
+		}
+
+	private:
+		L left_;
+		R right_;
+	};
+
+	/**
+	 * @brief True for the lazy expression types.
+	 */
+	template<typename E>
+	static constexpr bool is_expression_v = std::is_base_of_v<CBigIntExpression, E>;
 
 //	--------------------------------------------------------------------------------------------------------------------
 
 	/**
 	 * @brief Default constructor initializing the big integer to zero.
 	 */
-	CBigInt() : sign_(CBigIntSign::ZERO), digits_(std::vector<CBigIntDigit>{0}) {}
+	CBigInt() : sign_(CBigIntSign::ZERO), digits_(CBigIntLimbs{0}) {}
 
 	/**
-	 * @brief Constructor initializing the big integer from an integer value.
+	 * @brief Constructor initializing the big integer from a native integer value.
 	 *
 	 * @param value Integer value to initialize the big integer.
 	 */
-	explicit CBigInt(const int& value) :
-			sign_((value < 0) ? CBigIntSign::NEGATIVE : (value > 0) ? CBigIntSign::POSITIVE : CBigIntSign::ZERO) {
-		if (sign_ == CBigIntSign::ZERO)
-			digits_.push_back(0);
-		else {
-			int abs_value = std::abs(value);
-			while (abs_value > 0) {
-				digits_.push_back(abs_value % 10);
-				abs_value /= 10;
-			}
-		}
+	template<std::integral T>
+	explicit CBigInt(T value) {
+		CIntegralLimbs_ value_limbs(value);
+		sign_ = value_limbs.sign;
+		digits_.assign(value_limbs.limbs, value_limbs.limbs + value_limbs.size);
 	}
 
 	/**
 	 * @brief Constructor initializing the big integer from a string value.
 	 *
+	 * Accepts std::string, string literals and other character buffers without copying them.
+	 *
 	 * @param value The string value to initialize the big integer.
 	 */
-	explicit CBigInt(const std::string& value) {
-		std::string normalized_value = normalizeStringInput_(value);
-		auto start_pos = normalized_value.cbegin(), end_pos = normalized_value.cend();
-
-		bool is_negative = (start_pos != end_pos && *start_pos == MINUS_);
-		start_pos = is_negative ? ++start_pos : start_pos;
-		if (start_pos == end_pos ||
-		    std::any_of(start_pos, end_pos, [](unsigned char c) { return !std::isdigit(c); }))
-			throw std::invalid_argument("Invalid value argument!");
-
-		auto start_aux_pos = start_pos;
-		bool is_zero = (*start_aux_pos == ZERO_ && ++start_aux_pos == end_pos);
-		sign_ = is_zero ? CBigIntSign::ZERO : is_negative ? CBigIntSign::NEGATIVE : CBigIntSign::POSITIVE;
-
-		digits_.reserve(std::distance(start_pos, end_pos));
-		for (auto current_pos = std::prev(end_pos); current_pos >= start_pos; --current_pos) {
-			CBigIntDigit current_digit = (*current_pos - ZERO_);
-			digits_.push_back(current_digit);
-
-			if (current_pos == start_pos)
-				break;
-		}
+	explicit CBigInt(std::string_view value) : CBigInt() {
+		assignDecimal_(value);
 	}
 
 	CBigInt(const CBigInt& x) = default;
 
+	CBigInt(CBigInt&& x) noexcept = default;
+
 	~CBigInt() = default;
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -113,12 +462,116 @@ public:
 	/**
 	 * @brief Get the digits of the big integer.
 	 *
-	 * @return A reference to the vector of digits.
+	 * @return A reference to the vector of binary limbs, least significant limb first.
 	 */
-	[[nodiscard]] const std::vector<CBigIntDigit>& getDigits() const {
+	[[nodiscard]] const CBigIntLimbs& getDigits() const {
 		return digits_;
 	}
 
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Configure parallel multiplication of huge operands.
+	 *
+	 * The Karatsuba recursion tree is split across up to the given number of threads, subproducts
+	 * whose shorter factor has fewer limbs than min_limbs are computed sequentially.
+	 *
+	 * @param threads The maximum number of threads per multiplication, 0 or 1 disables parallelism.
+	 * @param min_limbs The minimum operand size in limbs for going parallel.
+	 */
+	static void setMultiplyThreads(size_t threads, size_t min_limbs = PARALLEL_THRESHOLD_) {
+		multiply_threads_.store(std::max<size_t>(threads, 1), std::memory_order_relaxed);
+		parallel_min_limbs_.store(std::max(min_limbs, KARATSUBA_THRESHOLD_), std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Get the maximum number of threads per multiplication.
+	 *
+	 * @return The number of threads.
+	 */
+	[[nodiscard]] static size_t getMultiplyThreads() {
+		return multiply_threads_.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Enable or disable the vectorized limb kernels, e.g. to compare them with the portable ones.
+	 *
+	 * The vectorized kernels are only used when the CPU supports AVX2.
+	 *
+	 * @param enabled True to use the vectorized kernels when available.
+	 */
+	static void setSimdKernels(bool enabled) {
+		use_simd_.store(enabled && has_avx2_, std::memory_order_relaxed);
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Add two batches element-wise, result[i] = x[i] + y[i].
+	 *
+	 * The results are computed in place, so their buffers are reused across calls. The result
+	 * batch may alias either input batch.
+	 *
+	 * @param x The first batch of addends.
+	 * @param y The second batch of addends.
+	 * @param result The batch receiving the sums.
+	 * @param threads The maximum number of threads, 0 or 1 runs on the calling thread.
+	 * @throw std::invalid_argument If the batches differ in size.
+	 */
+	static void addMany(std::span<const CBigInt> x, std::span<const CBigInt> y, std::span<CBigInt> result,
+	                    size_t threads = 1) {
+		if (x.size() != y.size() || x.size() != result.size())
+			throw std::invalid_argument("Batch size mismatch!");
+
+		runBatch_(x.size(), threads, [&](size_t begin, size_t end, size_t) {
+			for (size_t i = begin; i < end; ++i)
+				result[i].assignSum_(x[i], y[i]);
+		});
+	}
+
+	/**
+	 * @brief Sum a batch of values.
+	 *
+	 * All values are accumulated into one preallocated buffer, the sum is normalized only once.
+	 *
+	 * @param x The values to sum.
+	 * @param threads The maximum number of threads, 0 or 1 runs on the calling thread.
+	 * @return The sum of the values.
+	 */
+	[[nodiscard]] static CBigInt sum(std::span<const CBigInt> x, size_t threads = 1) {
+		size_t bound = 0;
+		for (const CBigInt& value : x)
+			bound = std::max(bound, value.digits_.size());
+
+		return accumulateBatch_(x.size(), bound, threads, [&](CAccumulator_& acc, size_t i) {
+			acc.add(x[i]);
+		});
+	}
+
+	/**
+	 * @brief Compute the dot product of two batches, the sum of x[i] * y[i].
+	 *
+	 * The products are accumulated straight into one preallocated buffer, no product is materialized.
+	 *
+	 * @param x The first batch of factors.
+	 * @param y The second batch of factors.
+	 * @param threads The maximum number of threads, 0 or 1 runs on the calling thread.
+	 * @return The dot product.
+	 * @throw std::invalid_argument If the batches differ in size.
+	 */
+	[[nodiscard]] static CBigInt dot(std::span<const CBigInt> x, std::span<const CBigInt> y, size_t threads = 1) {
+		if (x.size() != y.size())
+			throw std::invalid_argument("Batch size mismatch!");
+
+		size_t bound = 0;
+		for (size_t i = 0; i < x.size(); ++i)
+			bound = std::max(bound, x[i].digits_.size() + y[i].digits_.size());
+
+		return accumulateBatch_(x.size(), bound, threads, [&](CAccumulator_& acc, size_t i) {
+			acc.add(x[i], &y[i]);
+		});
+	}
+
 //	--------------------------------------------------------------------------------------------------------------------
 
 	/**
@@ -137,6 +590,19 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief Move assignment operator.
+	 *
+	 * @param x The CBigInt object to move from.
+	 * @return A reference to this CBigInt object.
+	 */
+	CBigInt& operator=(CBigInt&& x) noexcept {
+		sign_ = x.sign_;
+		digits_ = std::move(x.digits_);
+
+		return *this;
+	}
+
 	/**
 	 * @brief Templated assignment operator.
 	 *
@@ -145,8 +611,14 @@ public:
 	 */
 	template<typename T>
 	CBigInt& operator=(const T& x) {
-		CBigInt tmp(x);
-		*this = tmp;
+		if constexpr (std::is_integral_v<T>) {
+			CIntegralLimbs_ x_limbs(x);
+			sign_ = x_limbs.sign;
+			digits_.assign(x_limbs.limbs, x_limbs.limbs + x_limbs.size);
+		} else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			assignDecimal_(x);
+		else
+			*this = CBigInt(x);
 
 		return *this;
 	}
@@ -156,50 +628,19 @@ public:
 	/**
 	 * @brief Addition operator for two CBigInt objects.
 	 *
+	 * The longer operand is copied into a buffer with room for the carry and the shorter one is
+	 * added in place, so the sum performs at most one allocation.
+	 *
 	 * @param x The first CBigInt object.
 	 * @param y The second CBigInt object.
 	 * @return The sum of the two CBigInt objects.
 	 */
 	friend CBigInt operator+(const CBigInt& x, const CBigInt& y) {
-		bool is_x_zero = (x.getSign() == CBigIntSign::ZERO), is_y_zero = (y.getSign() == CBigIntSign::ZERO);
-		if (is_x_zero || is_y_zero)
-			return is_x_zero ? y : x;
-
-		CBigInt result;
-		result.digits_.clear();
-
-		bool is_eq_sign = (x.getSign() == y.getSign());
-		if (is_eq_sign) {
-			size_t x_len = x.getDigits().size(), y_len = y.getDigits().size(), max_len = std::max(x_len, y_len);
-			result.sign_ = x.getSign();
-			result.digits_.reserve(max_len + 1);
-
-			int carry = 0;
-			for (size_t i = 0; i < max_len || carry; ++i) {
-				int sum = ((i < x_len) ? x.getDigits()[i] : 0) + ((i < y_len) ? y.getDigits()[i] : 0) + carry;
-				result.digits_.push_back(sum % 10);
-				carry = sum / 10;
-			}
-		} else {
-			int comparison = compareAbs_(x, y);
-			bool is_x_lt_y = (comparison < 0), is_x_eq_y = (comparison == 0);
-			if (is_x_eq_y)
-				return result;
-
-			const CBigInt& lesser = is_x_lt_y ? x : y, greater = is_x_lt_y ? y : x;
-			size_t lesser_len = lesser.getDigits().size(), greater_len = greater.getDigits().size();
-			result.sign_ = greater.getSign();
-			result.digits_.reserve(greater_len);
-
-			int borrow = 0;
-			for (size_t i = 0; i < greater_len; ++i) {
-				int sub = greater.getDigits()[i] - ((i < lesser_len) ? lesser.getDigits()[i] : 0) - borrow;
-				borrow = (sub < 0);
-				result.digits_.push_back(borrow ? (sub + 10) : sub);
-			}
+		bool is_x_longer = (x.getDigits().size() >= y.getDigits().size());
+		const CBigInt &longer = is_x_longer ? x : y, &shorter = is_x_longer ? y : x;
 
-			normalizeDigits_(result);
-		}
+		CBigInt result = withCapacity_(longer, 1);
+		result.addSigned_(shorter.sign_, shorter.digits_.data(), shorter.digits_.size());
 
 		return result;
 	}
@@ -213,7 +654,11 @@ public:
 	 */
 	template<typename T>
 	friend CBigInt operator+(const CBigInt& x, const T& y) {
-		return x + CBigInt(y);
+		if constexpr (std::is_integral_v<T>) {
+			CBigInt result = withCapacity_(x, 1);
+			return result += y;
+		} else
+			return x + CBigInt(y);
 	}
 
 	/**
@@ -225,7 +670,46 @@ public:
 	 */
 	template<typename T>
 	friend CBigInt operator+(const T& x, const CBigInt& y) {
-		return CBigInt(x) + y;
+		return y + x;
+	}
+
+	/**
+	 * @brief Addition operator for two lazy expressions.
+	 *
+	 * Chains such as b * c + d * e + f are evaluated in a single pass: every product is multiplied
+	 * and accumulated straight into one preallocated result buffer.
+	 *
+	 * @param x The first expression.
+	 * @param y The second expression.
+	 * @return The lazy sum.
+	 */
+	template<typename L, typename R> requires (is_expression_v<L> && is_expression_v<R>)
+	friend CBigIntSum<L, R> operator+(const L& x, const R& y) {
+		return {x, y};
+	}
+
+	/**
+	 * @brief Addition operator for a lazy expression and CBigInt.
+	 *
+	 * @param x The expression.
+	 * @param y The CBigInt object.
+	 * @return The lazy sum.
+	 */
+	template<typename L> requires is_expression_v<L>
+	friend CBigIntSum<L, CBigIntTerm> operator+(const L& x, const CBigInt& y) {
+		return {x, CBigIntTerm(y)};
+	}
+
+	/**
+	 * @brief Addition operator for CBigInt and a lazy expression.
+	 *
+	 * @param x The CBigInt object.
+	 * @param y The expression.
+	 * @return The lazy sum.
+	 */
+	template<typename R> requires is_expression_v<R>
+	friend CBigIntSum<CBigIntTerm, R> operator+(const CBigInt& x, const R& y) {
+		return {CBigIntTerm(x), y};
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -233,24 +717,40 @@ public:
 	/**
 	 * @brief Addition assignment operator for two CBigInt objects.
 	 *
+	 * The sum is computed in place, reusing the buffer of x whenever its capacity suffices.
+	 *
 	 * @param x The CBigInt object to add to.
 	 * @param y The CBigInt object to add.
 	 * @return A reference to the resulting CBigInt object.
 	 */
-	friend CBigInt operator+=(CBigInt& x, const CBigInt& y) {
-		return x = x + y;
+	friend CBigInt& operator+=(CBigInt& x, const CBigInt& y) {
+		if (&x == &y) {
+			CBigInt copy(y);
+			return x += copy;
+		}
+
+		x.addSigned_(y.sign_, y.digits_.data(), y.digits_.size());
+
+		return x;
 	}
 
 	/**
 	 * @brief Templated addition assignment operator for CBigInt and another type.
 	 *
+	 * Native integers are added straight from their limbs without building a CBigInt.
+	 *
 	 * @param x The CBigInt object to add to.
 	 * @param y The value to add.
 	 * @return A reference to the resulting CBigInt object.
 	 */
 	template<typename T>
-	friend CBigInt operator+=(CBigInt& x, const T& y) {
-		return x += CBigInt(y);
+	friend CBigInt& operator+=(CBigInt& x, const T& y) {
+		if constexpr (std::is_integral_v<T>) {
+			CIntegralLimbs_ y_limbs(y);
+			x.addSigned_(y_limbs.sign, y_limbs.limbs, y_limbs.size);
+			return x;
+		} else
+			return x += CBigInt(y);
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -258,38 +758,15 @@ public:
 	/**
 	 * @brief Multiplication operator for two CBigInt objects.
 	 *
+	 * The product is lazy, it is computed when converted to CBigInt or fused into a surrounding sum.
+	 *
 	 * @param x The first CBigInt object.
 	 * @param y The second CBigInt object.
-	 * @return The product of the two CBigInt objects.
+	 * @return The lazy product of the two CBigInt objects.
 	 */
-	friend CBigInt operator*(const CBigInt& x, const CBigInt& y) {
-		CBigInt result;
-
-		bool is_x_zero = (x.getSign() == CBigIntSign::ZERO), is_y_zero = (y.getSign() == CBigIntSign::ZERO),
-				is_eq_sign = (x.getSign() == y.getSign());
-		if (is_x_zero || is_y_zero)
-			return result;
-
-		size_t x_len = x.getDigits().size(), y_len = y.getDigits().size();
-		result.sign_ = is_eq_sign ? CBigIntSign::POSITIVE : CBigIntSign::NEGATIVE;
-		result.digits_.resize(x_len + y_len, 0);
-
-		for (size_t i = 0; i < x_len; ++i) {
-			int carry = 0;
-			for (size_t j = 0; j < y_len || carry; ++j) {
-				int sum = result.digits_[i + j] + carry;
-				if (j < y_len)
-					sum += x.getDigits()[i] * y.getDigits()[j];
-
-				result.digits_[i + j] = sum % 10;
-				carry = sum / 10;
-			}
-		}
-
-		normalizeDigits_(result);
-
-		return result;
-	}
+	friend CBigIntProduct operator*(const CBigInt& x, const CBigInt& y) {
+		return {x, y};
+	}
 
 	/**
 	 * @brief Templated multiplication operator for CBigInt and another type.
@@ -300,7 +777,13 @@ public:
 	 */
 	template<typename T>
 	friend CBigInt operator*(const CBigInt& x, const T& y) {
-		return x * CBigInt(y);
+		if constexpr (std::is_integral_v<T>) {
+			CIntegralLimbs_ y_limbs(y);
+			CBigInt result = withCapacity_(x, y_limbs.size);
+			result.mulSigned_(y_limbs.sign, y_limbs.limbs, y_limbs.size);
+			return result;
+		} else
+			return x * CBigInt(y);
 	}
 
 	/**
@@ -312,7 +795,7 @@ public:
 	 */
 	template<typename T>
 	friend CBigInt operator*(const T& x, const CBigInt& y) {
-		return CBigInt(x) * y;
+		return y * x;
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -320,24 +803,229 @@ public:
 	/**
 	 * @brief Multiplication assignment operator for two CBigInt objects.
 	 *
+	 * The product is formed in a per-thread scratch buffer and copied back into the buffer of x,
+	 * so repeated multiplications stop allocating once the buffers have grown.
+	 *
 	 * @param x The CBigInt object to multiply.
 	 * @param y The CBigInt object to multiply with.
 	 * @return A reference to the resulting CBigInt object.
 	 */
-	friend CBigInt operator*=(CBigInt& x, const CBigInt& y) {
-		return x = x * y;
+	friend CBigInt& operator*=(CBigInt& x, const CBigInt& y) {
+		x.mulSigned_(y.sign_, y.digits_.data(), y.digits_.size());
+
+		return x;
 	}
 
 	/**
 	 * @brief Templated multiplication assignment operator for CBigInt and another type.
 	 *
+	 * Native integers are multiplied straight from their limbs without building a CBigInt.
+	 *
 	 * @param x The CBigInt object to multiply.
 	 * @param y The value to multiply with.
 	 * @return A reference to the resulting CBigInt object.
 	 */
 	template<typename T>
-	friend CBigInt operator*=(CBigInt& x, const T& y) {
-		return x *= CBigInt(y);
+	friend CBigInt& operator*=(CBigInt& x, const T& y) {
+		if constexpr (std::is_integral_v<T>) {
+			CIntegralLimbs_ y_limbs(y);
+			x.mulSigned_(y_limbs.sign, y_limbs.limbs, y_limbs.size);
+			return x;
+		} else
+			return x *= CBigInt(y);
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Quotient and remainder of two CBigInt objects.
+	 *
+	 * The quotient is truncated towards zero and the remainder takes the sign of the dividend,
+	 * matching the semantics of the built-in integer division.
+	 *
+	 * @param x The dividend.
+	 * @param y The divisor.
+	 * @return A pair of the quotient and the remainder.
+	 * @throws std::invalid_argument If the divisor is zero.
+	 */
+	friend std::pair<CBigInt, CBigInt> divmod(const CBigInt& x, const CBigInt& y) {
+		if (y.getSign() == CBigIntSign::ZERO)
+			throw std::invalid_argument("Division by zero!");
+
+		CBigInt quotient, remainder;
+		if (x.getSign() == CBigIntSign::ZERO)
+			return {quotient, remainder};
+
+		divmodAbs_(x.getDigits(), y.getDigits(), quotient.digits_, remainder.digits_);
+
+		bool is_q_zero = (quotient.digits_.size() == 1 && quotient.digits_[0] == 0),
+		     is_r_zero = (remainder.digits_.size() == 1 && remainder.digits_[0] == 0);
+		quotient.sign_ = is_q_zero ? CBigIntSign::ZERO :
+		                 (x.getSign() == y.getSign()) ? CBigIntSign::POSITIVE : CBigIntSign::NEGATIVE;
+		remainder.sign_ = is_r_zero ? CBigIntSign::ZERO : x.getSign();
+
+		return {quotient, remainder};
+	}
+
+	/**
+	 * @brief Division operator for two CBigInt objects.
+	 *
+	 * @param x The dividend.
+	 * @param y The divisor.
+	 * @return The quotient truncated towards zero.
+	 * @throws std::invalid_argument If the divisor is zero.
+	 */
+	friend CBigInt operator/(const CBigInt& x, const CBigInt& y) {
+		return divmod(x, y).first;
+	}
+
+	/**
+	 * @brief Templated division operator for CBigInt and another type.
+	 *
+	 * @param x The dividend.
+	 * @param y The divisor value.
+	 * @return The quotient as a CBigInt object.
+	 */
+	template<typename T>
+	friend CBigInt operator/(const CBigInt& x, const T& y) {
+		return x / CBigInt(y);
+	}
+
+	/**
+	 * @brief Templated division operator for another type and CBigInt.
+	 *
+	 * @param x The dividend value.
+	 * @param y The divisor.
+	 * @return The quotient as a CBigInt object.
+	 */
+	template<typename T>
+	friend CBigInt operator/(const T& x, const CBigInt& y) {
+		return CBigInt(x) / y;
+	}
+
+	/**
+	 * @brief Modulo operator for two CBigInt objects.
+	 *
+	 * @param x The dividend.
+	 * @param y The divisor.
+	 * @return The remainder, having the sign of the dividend.
+	 * @throws std::invalid_argument If the divisor is zero.
+	 */
+	friend CBigInt operator%(const CBigInt& x, const CBigInt& y) {
+		return divmod(x, y).second;
+	}
+
+	/**
+	 * @brief Templated modulo operator for CBigInt and another type.
+	 *
+	 * @param x The dividend.
+	 * @param y The divisor value.
+	 * @return The remainder as a CBigInt object.
+	 */
+	template<typename T>
+	friend CBigInt operator%(const CBigInt& x, const T& y) {
+		return x % CBigInt(y);
+	}
+
+	/**
+	 * @brief Templated modulo operator for another type and CBigInt.
+	 *
+	 * @param x The dividend value.
+	 * @param y The divisor.
+	 * @return The remainder as a CBigInt object.
+	 */
+	template<typename T>
+	friend CBigInt operator%(const T& x, const CBigInt& y) {
+		return CBigInt(x) % y;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Division assignment operator for two CBigInt objects.
+	 *
+	 * @param x The CBigInt object to divide.
+	 * @param y The divisor.
+	 * @return A reference to the resulting CBigInt object.
+	 */
+	friend CBigInt& operator/=(CBigInt& x, const CBigInt& y) {
+		return x = x / y;
+	}
+
+	/**
+	 * @brief Templated division assignment operator for CBigInt and another type.
+	 *
+	 * @param x The CBigInt object to divide.
+	 * @param y The divisor value.
+	 * @return A reference to the resulting CBigInt object.
+	 */
+	template<typename T>
+	friend CBigInt& operator/=(CBigInt& x, const T& y) {
+		return x /= CBigInt(y);
+	}
+
+	/**
+	 * @brief Modulo assignment operator for two CBigInt objects.
+	 *
+	 * @param x The CBigInt object to reduce.
+	 * @param y The divisor.
+	 * @return A reference to the resulting CBigInt object.
+	 */
+	friend CBigInt& operator%=(CBigInt& x, const CBigInt& y) {
+		return x = x % y;
+	}
+
+	/**
+	 * @brief Templated modulo assignment operator for CBigInt and another type.
+	 *
+	 * @param x The CBigInt object to reduce.
+	 * @param y The divisor value.
+	 * @return A reference to the resulting CBigInt object.
+	 */
+	template<typename T>
+	friend CBigInt& operator%=(CBigInt& x, const T& y) {
+		return x %= CBigInt(y);
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Modular exponentiation.
+	 *
+	 * Odd moduli are handled with Montgomery multiplication and a fixed 4-bit window, so no division
+	 * is performed inside the exponentiation loop. Even moduli fall back to square-and-multiply
+	 * with a full reduction after every step.
+	 *
+	 * @param base The base, may be negative.
+	 * @param exponent The non-negative exponent.
+	 * @param modulus The positive modulus.
+	 * @return base^exponent mod modulus, in the range [0, modulus).
+	 * @throws std::invalid_argument If the exponent is negative or the modulus is not positive.
+	 */
+	friend CBigInt powmod(const CBigInt& base, const CBigInt& exponent, const CBigInt& modulus) {
+		if (exponent.getSign() == CBigIntSign::NEGATIVE || modulus.getSign() != CBigIntSign::POSITIVE)
+			throw std::invalid_argument("Invalid powmod argument!");
+
+		CBigInt result;
+		const CBigIntLimbs& m = modulus.getDigits();
+		if (m.size() == 1 && m[0] == 1)
+			return result;
+
+		CBigIntLimbs q, b;
+		divmodAbs_(base.getDigits(), m, q, b);
+		bool is_b_zero = (b.size() == 1 && b[0] == 0);
+		if (base.getSign() == CBigIntSign::NEGATIVE && !is_b_zero) {
+			CBigIntLimbs m_minus_b;
+			subAbs_(m, b, m_minus_b);
+			b.swap(m_minus_b);
+		}
+
+		result.digits_ = (m[0] & 1) ? powmodMontgomery_(b, exponent.getDigits(), m)
+		                            : powmodPlain_(b, exponent.getDigits(), m);
+		bool is_r_zero = (result.digits_.size() == 1 && result.digits_[0] == 0);
+		result.sign_ = is_r_zero ? CBigIntSign::ZERO : CBigIntSign::POSITIVE;
+
+		return result;
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -364,7 +1052,7 @@ public:
 	 */
 	template<typename T>
 	friend bool operator==(const CBigInt& x, const T& y) {
-		return x == CBigInt(y);
+		return compareWith_(x, y) == 0;
 	}
 
 	/**
@@ -376,7 +1064,7 @@ public:
 	 */
 	template<typename T>
 	friend bool operator==(const T& x, const CBigInt& y) {
-		return CBigInt(x) == y;
+		return compareWith_(y, x) == 0;
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -401,7 +1089,7 @@ public:
 	 */
 	template<typename T>
 	friend bool operator!=(const CBigInt& x, const T& y) {
-		return x != CBigInt(y);
+		return compareWith_(x, y) != 0;
 	}
 
 	/**
@@ -413,7 +1101,7 @@ public:
 	 */
 	template<typename T>
 	friend bool operator!=(const T& x, const CBigInt& y) {
-		return CBigInt(x) != y;
+		return compareWith_(y, x) != 0;
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -434,269 +1122,2058 @@ public:
 		bool is_both_positive = (x.getSign() == CBigIntSign::POSITIVE),
 	         is_x_lt_y = ((is_both_positive && comparison < 0) || (!is_both_positive && comparison > 0));
 
-		return is_x_lt_y;
+		return is_x_lt_y;
+	}
+
+	/**
+	 * @brief Templated less than operator for CBigInt and another type.
+	 *
+	 * @param x The CBigInt object.
+	 * @param y The value to compare.
+	 * @return True if the CBigInt object is less than the value, false otherwise.
+	 */
+	template<typename T>
+	friend bool operator<(const CBigInt& x, const T& y) {
+		return compareWith_(x, y) < 0;
+	}
+
+	/**
+	 * @brief Templated less than operator for another type and CBigInt.
+	 *
+	 * @param x The value to compare.
+	 * @param y The CBigInt object.
+	 * @return True if the value is less than the CBigInt object, false otherwise.
+	 */
+	template<typename T>
+	friend bool operator<(const T& x, const CBigInt& y) {
+		return compareWith_(y, x) > 0;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Less than or equal to operator for two CBigInt objects.
+	 *
+	 * @param x The first CBigInt object.
+	 * @param y The second CBigInt object.
+	 * @return True if the first CBigInt object is less than or equal to the second, false otherwise.
+	 */
+	friend bool operator<=(const CBigInt& x, const CBigInt& y) {
+		return (x < y) || (x == y);
+	}
+
+	/**
+	 * @brief Templated less than or equal to operator for CBigInt and another type.
+	 *
+	 * @param x The CBigInt object.
+	 * @param y The value to compare.
+	 * @return True if the CBigInt object is less than or equal to the value, false otherwise.
+	 */
+	template<typename T>
+	friend bool operator<=(const CBigInt& x, const T& y) {
+		return compareWith_(x, y) <= 0;
+	}
+
+	/**
+	 * @brief Templated less than or equal to operator for another type and CBigInt.
+	 *
+	 * @param x The value to compare.
+	 * @param y The CBigInt object.
+	 * @return True if the value is less than or equal to the CBigInt object, false otherwise.
+	 */
+	template<typename T>
+	friend bool operator<=(const T& x, const CBigInt& y) {
+		return compareWith_(y, x) >= 0;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Greater than operator for two CBigInt objects.
+	 *
+	 * @param x The first CBigInt object.
+	 * @param y The second CBigInt object.
+	 * @return True if the first CBigInt object is greater than the second, false otherwise.
+	 */
+	friend bool operator>(const CBigInt& x, const CBigInt& y) {
+		return y < x;
+	}
+	/**
+	* @brief Templated greater than operator for CBigInt and another type.
+	*
+	* @param x The CBigInt object
+	* @param y The value to compare.
+	* @return True if the CBigInt object is greater than the value, false otherwise.
+	*/
+	template<typename T>
+	friend bool operator>(const CBigInt& x, const T& y) {
+		return compareWith_(x, y) > 0;
+	}
+
+	/**
+	 * @brief Templated greater than operator for another type and CBigInt.
+	 *
+	 * @param x The value to compare.
+	 * @param y The CBigInt object.
+	 * @return True if the value is greater than the CBigInt object, false otherwise.
+	 */
+	template<typename T>
+	friend bool operator>(const T& x, const CBigInt& y) {
+		return compareWith_(y, x) < 0;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Greater than or equal to operator for two CBigInt objects.
+	 *
+	 * @param x The first CBigInt object.
+	 * @param y The second CBigInt object.
+	 * @return True if the first CBigInt object is greater than or equal to the second, false otherwise.
+	 */
+	friend bool operator>=(const CBigInt& x, const CBigInt& y) {
+		return (x > y) || (x == y);
+	}
+
+	/**
+	 * @brief Templated greater than or equal to operator for CBigInt and another type.
+	 *
+	 * @param x The CBigInt object.
+	 * @param y The value to compare.
+	 * @return True if the CBigInt object is greater than or equal to the value, false otherwise.
+	 */
+	template<typename T>
+	friend bool operator>=(const CBigInt& x, const T& y) {
+		return compareWith_(x, y) >= 0;
+	}
+
+	/**
+	 * @brief Templated greater than or equal to operator for another type and CBigInt.
+	 *
+	 * @param x The value to compare.
+	 * @param y The CBigInt object.
+	 * @return True if the value is greater than or equal to the CBigInt object, false otherwise.
+	 */
+	template<typename T>
+	friend bool operator>=(const T& x, const CBigInt& y) {
+		return compareWith_(y, x) <= 0;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Output stream operator for CBigInt.
+	 *
+	 * Honors std::hex (and std::uppercase), decimal output is used otherwise.
+	 *
+	 * @param os The output stream.
+	 * @param x The CBigInt object to output.
+	 * @return A reference to the output stream.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, const CBigInt& x) {
+		std::string str;
+
+		bool is_negative = (x.sign_ == CBigIntSign::NEGATIVE);
+		if (is_negative)
+			str.push_back(MINUS_);
+
+		bool is_hex = ((os.flags() & std::ios::basefield) == std::ios::hex);
+		if (is_hex)
+			printHex_(x.getDigits(), (os.flags() & std::ios::uppercase) != 0, str);
+		else
+			printDecimal_(x.getDigits(), 0, str);
+
+		return os << str;
+	}
+
+	/**
+	 * @brief Parse a decimal big integer from a character range, in the manner of std::from_chars.
+	 *
+	 * Accepts an optional minus sign followed by decimal digits, without skipping leading whitespace.
+	 * The limbs are written straight into value, which is left unchanged on failure.
+	 *
+	 * @param first The first character.
+	 * @param last The position past the last character.
+	 * @param value The CBigInt object to store the result in.
+	 * @return The position past the parsed digits, or first with std::errc::invalid_argument if there are none.
+	 */
+	friend std::from_chars_result from_chars(const char* first, const char* last, CBigInt& value) {
+		bool is_negative = (first != last && *first == MINUS_);
+		const char* digits_begin = first + is_negative;
+		const char* digits_end = std::find_if_not(digits_begin, last, isDecimalDigit_);
+		if (digits_begin == digits_end)
+			return {first, std::errc::invalid_argument};
+
+		value.assignDigits_(is_negative, digits_begin, digits_end);
+
+		return {digits_end, std::errc{}};
+	}
+
+	/**
+	 * @brief Input stream operator for CBigInt.
+	 *
+	 * @param is The input stream.
+	 * @param x The CBigInt object to input.
+	 * @return A reference to the input stream.
+	 */
+	friend std::istream& operator>>(std::istream& is, CBigInt& x) {
+		std::string value;
+		char c;
+
+		while (std::isspace(is.peek()))
+			is.get();
+
+		if (is.peek() == MINUS_) {
+			is.get(c);
+			value.push_back(c);
+		}
+
+		bool is_valid = false;
+		while (std::isdigit(is.peek())) {
+			is_valid = true;
+			is.get(c);
+			value.push_back(c);
+		}
+
+		if (is_valid)
+			x = CBigInt(value);
+		else
+			is.setstate(std::ios::failbit);
+
+		return is;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+private:
+//	--------------------------------------------------------------------------------------------------------------------
+
+	template<size_t Bits>
+	friend class CFixedBigInt;
+
+	static constexpr const char MINUS_ = '-', ZERO_ = '0';
+	static constexpr const unsigned LIMB_BITS_ = 32;
+	static constexpr const size_t DECIMAL_CHUNK_DIGITS_ = 9;
+	static constexpr const CBigIntDigit DECIMAL_CHUNK_BASE_ = 1000000000;
+	static constexpr const size_t POWMOD_WINDOW_BITS_ = 4;
+	static constexpr const size_t KARATSUBA_THRESHOLD_ = 32, NEWTON_THRESHOLD_ = 192, RADIX_THRESHOLD_ = 32;
+	static constexpr const size_t PARALLEL_THRESHOLD_ = 1024, BATCH_BLOCK_ = 1024;
+
+	static inline std::atomic<size_t> multiply_threads_ = 1, parallel_min_limbs_ = PARALLEL_THRESHOLD_;
+
+	static constexpr const size_t SIMD_LANES_ = 8, SIMD_THRESHOLD_ = 16;
+
+#ifdef CBIGINT_AVX2_KERNELS
+	static inline const bool has_avx2_ = []() {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+	}();
+#else
+	static constexpr const bool has_avx2_ = false;
+#endif
+
+	static inline std::atomic<bool> use_simd_ = has_avx2_;
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Fixed-size signed accumulator of terms and products.
+	 *
+	 * Positive terms are accumulated into one buffer, negative ones into a second buffer that is
+	 * subtracted at the end, so the whole sum is normalized only once.
+	 */
+	class CAccumulator_ {
+	public:
+		explicit CAccumulator_(size_t limbs) : positive_(limbs, 0) {}
+
+		/**
+		 * @brief Add a term, or a product when the second factor is given.
+		 *
+		 * @param x The term or the first factor.
+		 * @param y The second factor, or nullptr for a plain term.
+		 */
+		void add(const CBigInt& x, const CBigInt* y = nullptr) {
+			CBigIntSign y_sign = y ? y->sign_ : CBigIntSign::POSITIVE;
+			if (x.sign_ == CBigIntSign::ZERO || y_sign == CBigIntSign::ZERO)
+				return;
+
+			CBigIntLimbs& acc = target_((x.sign_ == CBigIntSign::NEGATIVE) != (y_sign == CBigIntSign::NEGATIVE));
+			if (y)
+				mulAccumulate_(acc.data(), acc.size(), x.digits_.data(), x.digits_.size(), y->digits_.data(),
+				               y->digits_.size());
+			else
+				addInPlace_(acc.data(), acc.size(), x.digits_.data(), x.digits_.size());
+		}
+
+		/**
+		 * @brief Add another accumulator of the same size.
+		 *
+		 * @param other The accumulator to add.
+		 */
+		void merge(const CAccumulator_& other) {
+			addInPlace_(positive_.data(), positive_.size(), other.positive_.data(), other.positive_.size());
+			if (!other.negative_.empty()) {
+				CBigIntLimbs& negative = target_(true);
+				addInPlace_(negative.data(), negative.size(), other.negative_.data(), other.negative_.size());
+			}
+		}
+
+		/**
+		 * @brief Normalize the accumulated sum, the accumulator is left empty.
+		 *
+		 * @return The accumulated sum.
+		 */
+		CBigInt finish() {
+			CBigInt result;
+			trimLimbs_(positive_);
+			result.digits_.swap(positive_);
+			if (result.digits_.size() > 1 || result.digits_[0] != 0)
+				result.sign_ = CBigIntSign::POSITIVE;
+
+			if (!negative_.empty()) {
+				trimLimbs_(negative_);
+				if (negative_.size() > 1 || negative_[0] != 0)
+					result.addSigned_(CBigIntSign::NEGATIVE, negative_.data(), negative_.size());
+			}
+
+			return result;
+		}
+
+	private:
+		CBigIntLimbs& target_(bool is_negative) {
+			if (!is_negative)
+				return positive_;
+			if (negative_.empty())
+				negative_.assign(positive_.size(), 0);
+
+			return negative_;
+		}
+
+		CBigIntLimbs positive_, negative_;
+	};
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	CBigIntSign sign_;
+	CBigIntLimbs digits_;
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Sign and limbs of a native integer, kept on the stack to avoid CBigInt temporaries.
+	 */
+	struct CIntegralLimbs_ {
+		static constexpr const size_t MAX_SIZE = 2;
+
+		template<std::integral T>
+		explicit CIntegralLimbs_(T value) :
+				sign(value ? CBigIntSign::POSITIVE : CBigIntSign::ZERO), limbs{0, 0}, size(1) {
+			static_assert(sizeof(T) <= MAX_SIZE * sizeof(CBigIntDigit), "Unsupported integral type!");
+
+			// bool has no unsigned counterpart and is never negative
+			uint64_t magnitude = static_cast<uint64_t>(value);
+			if constexpr (std::is_signed_v<T>) {
+				if (value < 0) {
+					sign = CBigIntSign::NEGATIVE;
+					magnitude = 0 - static_cast<uint64_t>(static_cast<int64_t>(value));
+				}
+			}
+
+			limbs[0] = static_cast<CBigIntDigit>(magnitude);
+			limbs[1] = static_cast<CBigIntDigit>(magnitude >> LIMB_BITS_);
+			size = limbs[1] ? 2 : 1;
+		}
+
+		CBigIntSign sign;
+		CBigIntDigit limbs[MAX_SIZE];
+		size_t size;
+	};
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Assign a decimal string with optional leading whitespace and minus sign, parsed in place.
+	 *
+	 * The whole string is validated first, so this object is left unchanged on invalid input.
+	 *
+	 * @param value The string value to assign.
+	 */
+	void assignDecimal_(std::string_view value) {
+		const char *begin = value.data(), *end = value.data() + value.size();
+		begin = std::find_if(begin, end, [](unsigned char c) { return !std::isspace(c); });
+
+		bool is_negative = (begin != end && *begin == MINUS_);
+		const char* digits_begin = begin + is_negative;
+		if (digits_begin == end || std::find_if_not(digits_begin, end, isDecimalDigit_) != end)
+			throw std::invalid_argument("Invalid value argument!");
+
+		assignDigits_(is_negative, digits_begin, end);
+	}
+
+	/**
+	 * @brief Assign a validated, non-empty run of decimal digits.
+	 *
+	 * @param is_negative True if the value is preceded by a minus sign.
+	 * @param begin The first digit.
+	 * @param end The position past the last digit.
+	 */
+	void assignDigits_(bool is_negative, const char* begin, const char* end) {
+		const char* significant = std::find_if(begin, end, [](char c) { return c != ZERO_; });
+		if (significant == end) {
+			sign_ = CBigIntSign::ZERO;
+			digits_.assign(1, 0);
+			return;
+		}
+
+		parseDecimal_(significant, end, digits_);
+		sign_ = is_negative ? CBigIntSign::NEGATIVE : CBigIntSign::POSITIVE;
+	}
+
+	/**
+	 * @brief Check for an ASCII decimal digit, independent of the current locale.
+	 *
+	 * @param c The character to check.
+	 * @return True if c is a decimal digit.
+	 */
+	static constexpr bool isDecimalDigit_(char c) {
+		return static_cast<unsigned char>(c - ZERO_) < 10;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Normalize the digits vector by removing leading zeros.
+	 *
+	 * @param x The CBigInt object to normalize.
+	 */
+	static void normalizeDigits_(CBigInt& x) {
+		trimLimbs_(x.digits_);
+	}
+
+	/**
+	 * @brief Remove leading zero limbs, keeping at least one limb.
+	 *
+	 * @param digits The limbs to normalize.
+	 */
+	static void trimLimbs_(CBigIntLimbs& digits) {
+		while ((digits.size() > 1) && (digits.back() == 0))
+			digits.pop_back();
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Compare the absolute values of two CBigInt objects.
+	 *
+	 * @param x The first CBigInt object.
+	 * @param y The second CBigInt object.
+	 * @return -1 if x < y, 0 if x == y, 1 if x > y.
+	 */
+	static int compareAbs_(const CBigInt& x, const CBigInt& y) {
+		return compareLimbs_(x.digits_, y.digits_);
+	}
+
+	/**
+	 * @brief Compare two signed values given as sign and normalized limbs.
+	 *
+	 * @return -1 if x < y, 0 if x == y, 1 if x > y.
+	 */
+	static int compareSigned_(CBigIntSign x_sign, const CBigIntDigit* x, size_t x_len,
+	                          CBigIntSign y_sign, const CBigIntDigit* y, size_t y_len) {
+		if (x_sign != y_sign)
+			return (x_sign < y_sign) ? -1 : 1;
+
+		int comparison = compareLimbs_(x, x_len, y, y_len);
+
+		return (x_sign == CBigIntSign::NEGATIVE) ? -comparison : comparison;
+	}
+
+	/**
+	 * @brief Compare a CBigInt object with another value, native integers are compared without a temporary.
+	 *
+	 * @param x The CBigInt object.
+	 * @param y The value to compare.
+	 * @return -1 if x < y, 0 if x == y, 1 if x > y.
+	 */
+	template<typename T>
+	static int compareWith_(const CBigInt& x, const T& y) {
+		if constexpr (std::is_integral_v<T>) {
+			CIntegralLimbs_ y_limbs(y);
+			return compareSigned_(x.sign_, x.digits_.data(), x.digits_.size(), y_limbs.sign, y_limbs.limbs, y_limbs.size);
+		} else {
+			CBigInt y_value(y);
+			return compareSigned_(x.sign_, x.digits_.data(), x.digits_.size(),
+			                      y_value.sign_, y_value.digits_.data(), y_value.digits_.size());
+		}
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Eagerly multiply two CBigInt objects.
+	 *
+	 * @param x The first CBigInt object.
+	 * @param y The second CBigInt object.
+	 * @return The product.
+	 */
+	static CBigInt multiply_(const CBigInt& x, const CBigInt& y) {
+		CBigInt result;
+
+		bool is_x_zero = (x.getSign() == CBigIntSign::ZERO), is_y_zero = (y.getSign() == CBigIntSign::ZERO),
+				is_eq_sign = (x.getSign() == y.getSign());
+		if (is_x_zero || is_y_zero)
+			return result;
+
+		size_t x_len = x.getDigits().size(), y_len = y.getDigits().size();
+		result.sign_ = is_eq_sign ? CBigIntSign::POSITIVE : CBigIntSign::NEGATIVE;
+		result.digits_.resize(x_len + y_len, 0);
+
+		mulAbs_(x.getDigits().data(), x_len, y.getDigits().data(), y_len, result.digits_.data());
+
+		normalizeDigits_(result);
+
+		return result;
+	}
+
+	/**
+	 * @brief Evaluate a lazy sum of terms and products.
+	 *
+	 * Positive terms are accumulated into the result buffer, negative ones into a second buffer that
+	 * is subtracted at the end, so the whole chain is normalized only once.
+	 *
+	 * @param expr The expression to evaluate.
+	 * @return The value of the expression.
+	 */
+	template<typename E>
+	static CBigInt evaluate_(const E& expr) {
+		// the sum of fewer than 2^32 terms below B^size fits into size + 1 limbs
+		CAccumulator_ acc(expr.maxTermSize() + 1);
+		expr.forEachTerm([&](const CBigInt& x, const CBigInt* y) {
+			acc.add(x, y);
+		});
+
+		return acc.finish();
+	}
+
+	/**
+	 * @brief Run a batch of independent elements in contiguous ranges on up to the given number of threads.
+	 *
+	 * Each range spans at least BATCH_BLOCK_ elements, smaller batches stay on the calling thread.
+	 *
+	 * @param count The number of elements.
+	 * @param threads The maximum number of threads.
+	 * @param task The task, called with the range bounds and the range index.
+	 */
+	template<typename F>
+	static void runBatch_(size_t count, size_t threads, const F& task) {
+		size_t ranges = std::clamp<size_t>(count / BATCH_BLOCK_, 1, std::max<size_t>(threads, 1));
+		if (ranges == 1) {
+			task(0, count, 0);
+			return;
+		}
+
+		runParallel_(ranges, ranges, [&](size_t range, size_t) {
+			task(range * count / ranges, (range + 1) * count / ranges, range);
+		});
+	}
+
+	/**
+	 * @brief Accumulate a batch of terms, each worker into its own accumulator merged at the end.
+	 *
+	 * @param count The number of elements.
+	 * @param bound The maximum term size in limbs.
+	 * @param threads The maximum number of threads.
+	 * @param add The callback adding the i-th term to an accumulator.
+	 * @return The sum of the terms.
+	 */
+	template<typename F>
+	static CBigInt accumulateBatch_(size_t count, size_t bound, size_t threads, const F& add) {
+		// the sum of fewer than 2^64 terms below B^bound fits into bound + 2 limbs
+		size_t ranges = std::clamp<size_t>(count / BATCH_BLOCK_, 1, std::max<size_t>(threads, 1));
+		std::vector<CAccumulator_> partials(ranges, CAccumulator_(bound + 2));
+
+		runBatch_(count, ranges, [&](size_t begin, size_t end, size_t range) {
+			for (size_t i = begin; i < end; ++i)
+				add(partials[range], i);
+		});
+
+		for (size_t range = 1; range < ranges; ++range)
+			partials[0].merge(partials[range]);
+
+		return partials[0].finish();
+	}
+
+	/**
+	 * @brief Assign the sum of two CBigInt objects, reusing the buffer of this object.
+	 *
+	 * @param x The first addend, may alias this object.
+	 * @param y The second addend, may alias this object.
+	 */
+	void assignSum_(const CBigInt& x, const CBigInt& y) {
+		if (this == &y) {
+			*this += x;
+			return;
+		}
+
+		if (this != &x) {
+			digits_.reserve(std::max(x.digits_.size(), y.digits_.size()) + 1);
+			*this = x;
+		}
+		*this += y;
+	}
+
+	/**
+	 * @brief Copy a CBigInt object into a buffer with room for the given number of extra limbs.
+	 *
+	 * @param x The CBigInt object to copy.
+	 * @param extra The number of extra limbs to reserve.
+	 * @return The copy.
+	 */
+	static CBigInt withCapacity_(const CBigInt& x, size_t extra) {
+		CBigInt result;
+		result.digits_.reserve(x.digits_.size() + extra);
+		result = x;
+
+		return result;
+	}
+
+	/**
+	 * @brief Add a signed value given as limbs to this object in place.
+	 *
+	 * @param y_sign The sign of the addend.
+	 * @param y The normalized addend limbs, must not alias this object.
+	 * @param y_len The number of addend limbs.
+	 */
+	void addSigned_(CBigIntSign y_sign, const CBigIntDigit* y, size_t y_len) {
+		if (y_sign == CBigIntSign::ZERO)
+			return;
+		if (sign_ == CBigIntSign::ZERO) {
+			sign_ = y_sign;
+			digits_.assign(y, y + y_len);
+			return;
+		}
+
+		size_t x_len = digits_.size();
+		if (sign_ == y_sign) {
+			digits_.resize(std::max(x_len, y_len) + 1, 0);
+			addInPlace_(digits_.data(), digits_.size(), y, y_len);
+		} else {
+			int comparison = compareLimbs_(digits_.data(), x_len, y, y_len);
+			if (comparison == 0) {
+				sign_ = CBigIntSign::ZERO;
+				digits_.assign(1, 0);
+				return;
+			}
+
+			if (comparison > 0)
+				subInPlace_(digits_.data(), x_len, y, y_len);
+			else {
+				digits_.resize(y_len, 0);
+				subReverseInPlace_(digits_.data(), y, y_len);
+				sign_ = y_sign;
+			}
+		}
+
+		trimLimbs_(digits_);
+	}
+
+	/**
+	 * @brief Multiply this object by a signed value given as limbs in place.
+	 *
+	 * @param y_sign The sign of the factor.
+	 * @param y The normalized factor limbs, may alias this object.
+	 * @param y_len The number of factor limbs.
+	 */
+	void mulSigned_(CBigIntSign y_sign, const CBigIntDigit* y, size_t y_len) {
+		if (sign_ == CBigIntSign::ZERO)
+			return;
+		if (y_sign == CBigIntSign::ZERO) {
+			sign_ = CBigIntSign::ZERO;
+			digits_.assign(1, 0);
+			return;
+		}
+
+		sign_ = (sign_ == y_sign) ? CBigIntSign::POSITIVE : CBigIntSign::NEGATIVE;
+		if (y_len == 1) {
+			mulAddSmall_(digits_, y[0], 0);
+			return;
+		}
+
+		static thread_local CBigIntLimbs product;
+		product.resize(digits_.size() + y_len);
+		mulAbs_(digits_.data(), digits_.size(), y, y_len, product.data());
+		trimLimbs_(product);
+		digits_.assign(product.begin(), product.end());
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Multiply limbs by a small factor and add a small addend in place.
+	 *
+	 * @param digits The limbs to update.
+	 * @param factor The factor.
+	 * @param addend The addend.
+	 */
+	static void mulAddSmall_(CBigIntLimbs& digits, CBigIntDigit factor, CBigIntDigit addend) {
+		CBigIntWideDigit carry = addend;
+		for (auto& digit : digits) {
+			CBigIntWideDigit product = static_cast<CBigIntWideDigit>(digit) * factor + carry;
+			digit = static_cast<CBigIntDigit>(product);
+			carry = product >> LIMB_BITS_;
+		}
+
+		if (carry)
+			digits.push_back(static_cast<CBigIntDigit>(carry));
+		trimLimbs_(digits);
+	}
+
+	/**
+	 * @brief Divide limbs by a small divisor in place.
+	 *
+	 * @param digits The limbs to divide, replaced by the normalized quotient.
+	 * @param divisor The non-zero divisor.
+	 * @return The remainder.
+	 */
+	static CBigIntDigit divSmall_(CBigIntLimbs& digits, CBigIntDigit divisor) {
+		CBigIntWideDigit remainder = 0;
+		for (auto digit_pos = digits.rbegin(); digit_pos != digits.rend(); ++digit_pos) {
+			CBigIntWideDigit current = (remainder << LIMB_BITS_) | *digit_pos;
+			*digit_pos = static_cast<CBigIntDigit>(current / divisor);
+			remainder = current % divisor;
+		}
+
+		trimLimbs_(digits);
+
+		return static_cast<CBigIntDigit>(remainder);
+	}
+
+	/**
+	 * @brief Subtract two magnitudes, the first one must not be smaller than the second one.
+	 *
+	 * @param x The minuend limbs.
+	 * @param y The subtrahend limbs.
+	 * @param result The normalized difference.
+	 */
+	static void subAbs_(const CBigIntLimbs& x, const CBigIntLimbs& y,
+	                    CBigIntLimbs& result) {
+		CBigIntLimbs difference = x;
+		subInPlace_(difference.data(), difference.size(), y.data(), y.size());
+		trimLimbs_(difference);
+		result.swap(difference);
+	}
+
+	/**
+	 * @brief Add limbs in place, x += y.
+	 *
+	 * @param x The augend limbs, updated in place.
+	 * @param x_len The number of augend limbs, at least y_len.
+	 * @param y The addend limbs.
+	 * @param y_len The number of addend limbs.
+	 * @return The carry out of the most significant limb.
+	 */
+	static CBigIntDigit addInPlace_(CBigIntDigit* x, size_t x_len, const CBigIntDigit* y, size_t y_len) {
+		CBigIntWideDigit carry = 0;
+		size_t i = 0;
+#ifdef CBIGINT_AVX2_KERNELS
+		if (y_len >= SIMD_THRESHOLD_ && use_simd_.load(std::memory_order_relaxed)) {
+			i = y_len - y_len % SIMD_LANES_;
+			carry = addAvx2_(x, x, y, i);
+		}
+#endif
+		for (; i < y_len; ++i) {
+			CBigIntWideDigit sum = static_cast<CBigIntWideDigit>(x[i]) + y[i] + carry;
+			x[i] = static_cast<CBigIntDigit>(sum);
+			carry = sum >> LIMB_BITS_;
+		}
+		for (; carry && i < x_len; ++i)
+			carry = (++x[i] == 0);
+
+		return static_cast<CBigIntDigit>(carry);
+	}
+
+	/**
+	 * @brief Subtract limbs in place, x -= y.
+	 *
+	 * @param x The minuend limbs, updated in place.
+	 * @param x_len The number of minuend limbs, at least y_len.
+	 * @param y The subtrahend limbs.
+	 * @param y_len The number of subtrahend limbs.
+	 * @return The borrow out of the most significant limb.
+	 */
+	static CBigIntDigit subInPlace_(CBigIntDigit* x, size_t x_len, const CBigIntDigit* y, size_t y_len) {
+		CBigIntWideDigit borrow = 0;
+		size_t i = 0;
+#ifdef CBIGINT_AVX2_KERNELS
+		if (y_len >= SIMD_THRESHOLD_ && use_simd_.load(std::memory_order_relaxed)) {
+			i = y_len - y_len % SIMD_LANES_;
+			borrow = subAvx2_(x, x, y, i);
+		}
+#endif
+		for (; i < y_len; ++i) {
+			CBigIntWideDigit sub = static_cast<CBigIntWideDigit>(x[i]) - y[i] - borrow;
+			x[i] = static_cast<CBigIntDigit>(sub);
+			borrow = (sub >> LIMB_BITS_) & 1;
+		}
+		for (; borrow && i < x_len; ++i)
+			borrow = (x[i]-- == 0);
+
+		return static_cast<CBigIntDigit>(borrow);
+	}
+
+	/**
+	 * @brief Reverse subtraction in place, x = y - x, where y is not smaller than x.
+	 *
+	 * @param x The subtrahend limbs zero extended to len limbs, replaced by the difference.
+	 * @param y The minuend limbs.
+	 * @param len The number of limbs.
+	 */
+	static void subReverseInPlace_(CBigIntDigit* x, const CBigIntDigit* y, size_t len) {
+		CBigIntWideDigit borrow = 0;
+		size_t i = 0;
+#ifdef CBIGINT_AVX2_KERNELS
+		if (len >= SIMD_THRESHOLD_ && use_simd_.load(std::memory_order_relaxed)) {
+			i = len - len % SIMD_LANES_;
+			borrow = subAvx2_(x, y, x, i);
+		}
+#endif
+		for (; i < len; ++i) {
+			CBigIntWideDigit sub = static_cast<CBigIntWideDigit>(y[i]) - x[i] - borrow;
+			x[i] = static_cast<CBigIntDigit>(sub);
+			borrow = (sub >> LIMB_BITS_) & 1;
+		}
+	}
+
+	/**
+	 * @brief Compare two normalized magnitudes.
+	 *
+	 * @param x The first limbs.
+	 * @param y The second limbs.
+	 * @return -1 if x < y, 0 if x == y, 1 if x > y.
+	 */
+	static int compareLimbs_(const CBigIntLimbs& x, const CBigIntLimbs& y) {
+		return compareLimbs_(x.data(), x.size(), y.data(), y.size());
+	}
+
+	/**
+	 * @brief Compare two normalized magnitudes given as raw limbs.
+	 *
+	 * @return -1 if x < y, 0 if x == y, 1 if x > y.
+	 */
+	static int compareLimbs_(const CBigIntDigit* x, size_t x_len, const CBigIntDigit* y, size_t y_len) {
+		if (x_len != y_len)
+			return (x_len < y_len) ? -1 : 1;
+
+		size_t i = x_len;
+#ifdef CBIGINT_AVX2_KERNELS
+		if (x_len >= SIMD_THRESHOLD_ && use_simd_.load(std::memory_order_relaxed)) {
+			size_t difference = compareAvx2_(x, y, x_len);
+			if (difference != x_len)
+				return (x[difference] < y[difference]) ? -1 : 1;
+			i = x_len % SIMD_LANES_;
+		}
+#endif
+		while (i-- > 0)
+			if (x[i] != y[i])
+				return (x[i] < y[i]) ? -1 : 1;
+
+		return 0;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+#ifdef CBIGINT_AVX2_KERNELS
+	/**
+	 * @brief Carry-in mask of eight lanes from their generate and propagate masks.
+	 *
+	 * A lane generates a carry when its own sum wraps and propagates one when its sum is all ones,
+	 * so a single integer addition resolves the whole carry chain, like a carry-lookahead adder.
+	 *
+	 * @param generate The lanes producing a carry.
+	 * @param propagate The lanes passing an incoming carry on.
+	 * @param carry The carry into the lowest lane, updated to the carry out of the highest lane.
+	 * @return The lanes receiving a carry.
+	 */
+	static unsigned resolveCarries_(unsigned generate, unsigned propagate, CBigIntWideDigit& carry) {
+		unsigned chain = ((generate << 1) | static_cast<unsigned>(carry)) + propagate;
+		carry = (chain >> SIMD_LANES_) & 1;
+
+		return (chain ^ propagate) & 0xFF;
+	}
+
+	/**
+	 * @brief Vectorized limb addition, result = x + y over a multiple of eight limbs.
+	 *
+	 * @param result The sum limbs, may alias x or y.
+	 * @param x The first addend limbs.
+	 * @param y The second addend limbs.
+	 * @param len The number of limbs, a multiple of eight.
+	 * @return The carry out of the most significant limb.
+	 */
+	[[gnu::target("avx2")]]
+	static CBigIntWideDigit addAvx2_(CBigIntDigit* result, const CBigIntDigit* x, const CBigIntDigit* y, size_t len) {
+		const __m256i bias = _mm256_set1_epi32(INT32_MIN), ones = _mm256_set1_epi32(-1),
+				lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), one = _mm256_set1_epi32(1);
+		CBigIntWideDigit carry = 0;
+
+		for (size_t i = 0; i < len; i += SIMD_LANES_) {
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)),
+					b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)), sum = _mm256_add_epi32(a, b);
+			// unsigned sum < a, compared as signed after flipping the top bits
+			__m256i wrapped = _mm256_cmpgt_epi32(_mm256_xor_si256(a, bias), _mm256_xor_si256(sum, bias));
+			unsigned generate = _mm256_movemask_ps(_mm256_castsi256_ps(wrapped)),
+					propagate = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, ones)));
+
+			unsigned carries = resolveCarries_(generate, propagate, carry);
+			__m256i increment = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(carries)), lanes), one);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_add_epi32(sum, increment));
+		}
+
+		return carry;
+	}
+
+	/**
+	 * @brief Vectorized limb subtraction, result = x - y over a multiple of eight limbs.
+	 *
+	 * @param result The difference limbs, may alias x or y.
+	 * @param x The minuend limbs.
+	 * @param y The subtrahend limbs.
+	 * @param len The number of limbs, a multiple of eight.
+	 * @return The borrow out of the most significant limb.
+	 */
+	[[gnu::target("avx2")]]
+	static CBigIntWideDigit subAvx2_(CBigIntDigit* result, const CBigIntDigit* x, const CBigIntDigit* y, size_t len) {
+		const __m256i bias = _mm256_set1_epi32(INT32_MIN), zero = _mm256_setzero_si256(),
+				lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), one = _mm256_set1_epi32(1);
+		CBigIntWideDigit borrow = 0;
+
+		for (size_t i = 0; i < len; i += SIMD_LANES_) {
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)),
+					b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)), difference = _mm256_sub_epi32(a, b);
+			__m256i wrapped = _mm256_cmpgt_epi32(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+			unsigned generate = _mm256_movemask_ps(_mm256_castsi256_ps(wrapped)),
+					propagate = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(difference, zero)));
+
+			unsigned borrows = resolveCarries_(generate, propagate, borrow);
+			__m256i decrement = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(borrows)), lanes), one);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_sub_epi32(difference, decrement));
+		}
+
+		return borrow;
+	}
+
+	/**
+	 * @brief Vectorized search for the most significant differing limb, eight limbs at a time.
+	 *
+	 * @param x The first limbs.
+	 * @param y The second limbs.
+	 * @param len The number of limbs.
+	 * @return The index of the most significant differing limb, or len when the top
+	 *         len - len % 8 limbs are equal.
+	 */
+	[[gnu::target("avx2")]]
+	static size_t compareAvx2_(const CBigIntDigit* x, const CBigIntDigit* y, size_t len) {
+		for (size_t i = len; i >= SIMD_LANES_; i -= SIMD_LANES_) {
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i - SIMD_LANES_)),
+					b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i - SIMD_LANES_));
+			unsigned equal = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+			if (equal != 0xFF)
+				return i - SIMD_LANES_ + (std::bit_width(~equal & 0xFFu) - 1);
+		}
+
+		return len;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+#endif
+
+	/**
+	 * @brief Schoolbook multiplication of two magnitudes.
+	 *
+	 * @param x The first factor limbs.
+	 * @param x_len The number of limbs of the first factor.
+	 * @param y The second factor limbs.
+	 * @param y_len The number of limbs of the second factor.
+	 * @param result The x_len + y_len product limbs, overwritten.
+	 */
+	static void mulSchoolbook_(const CBigIntDigit* x, size_t x_len, const CBigIntDigit* y, size_t y_len,
+	                           CBigIntDigit* result) {
+		std::fill(result, result + x_len + y_len, 0);
+
+		for (size_t i = 0; i < x_len; ++i) {
+			CBigIntWideDigit carry = 0;
+			for (size_t j = 0; j < y_len; ++j) {
+				CBigIntWideDigit sum = result[i + j] + static_cast<CBigIntWideDigit>(x[i]) * y[j] + carry;
+				result[i + j] = static_cast<CBigIntDigit>(sum);
+				carry = sum >> LIMB_BITS_;
+			}
+			result[i + y_len] = static_cast<CBigIntDigit>(carry);
+		}
+	}
+
+	/**
+	 * @brief Multiply two magnitudes and add the product into an accumulator, acc += x * y.
+	 *
+	 * @param acc The accumulator limbs, large enough to hold the result.
+	 * @param acc_len The number of accumulator limbs.
+	 * @param x The first factor limbs.
+	 * @param x_len The number of limbs of the first factor.
+	 * @param y The second factor limbs.
+	 * @param y_len The number of limbs of the second factor.
+	 */
+	static void mulAccumulate_(CBigIntDigit* acc, size_t acc_len, const CBigIntDigit* x, size_t x_len,
+	                           const CBigIntDigit* y, size_t y_len) {
+		if (x_len < y_len) {
+			std::swap(x, y);
+			std::swap(x_len, y_len);
+		}
+
+		if (y_len >= KARATSUBA_THRESHOLD_) {
+			static thread_local CBigIntLimbs product;
+			product.resize(x_len + y_len);
+			mulAbs_(x, x_len, y, y_len, product.data());
+			trimLimbs_(product);
+			addInPlace_(acc, acc_len, product.data(), product.size());
+			return;
+		}
+
+		for (size_t i = 0; i < y_len; ++i) {
+			CBigIntWideDigit carry = 0;
+			for (size_t j = 0; j < x_len; ++j) {
+				CBigIntWideDigit sum = acc[i + j] + static_cast<CBigIntWideDigit>(y[i]) * x[j] + carry;
+				acc[i + j] = static_cast<CBigIntDigit>(sum);
+				carry = sum >> LIMB_BITS_;
+			}
+			for (size_t k = i + x_len; carry && k < acc_len; ++k) {
+				CBigIntWideDigit sum = acc[k] + carry;
+				acc[k] = static_cast<CBigIntDigit>(sum);
+				carry = sum >> LIMB_BITS_;
+			}
+		}
+	}
+
+	/**
+	 * @brief Run independent tasks on up to the given number of threads, the caller works as well.
+	 *
+	 * @param count The number of tasks.
+	 * @param threads The thread budget, split among the tasks.
+	 * @param task The task, called with the task index and its own thread budget.
+	 */
+	template<typename F>
+	static void runParallel_(size_t count, size_t threads, const F& task) {
+		size_t workers = std::min(count, threads);
+		auto work = [&](size_t worker) {
+			for (size_t i = worker; i < count; i += workers)
+				task(i, std::max<size_t>(threads / count + (i < threads % count), 1));
+		};
+
+		std::vector<std::future<void>> pending;
+		pending.reserve(workers);
+		for (size_t worker = 1; worker < workers; ++worker)
+			pending.push_back(std::async(std::launch::async, work, worker));
+		work(0);
+
+		for (auto& future : pending)
+			future.get();
+	}
+
+	/**
+	 * @brief Multiply two magnitudes, using the configured number of threads for huge operands.
+	 *
+	 * @param x The first factor limbs.
+	 * @param x_len The number of limbs of the first factor.
+	 * @param y The second factor limbs.
+	 * @param y_len The number of limbs of the second factor.
+	 * @param result The x_len + y_len product limbs, overwritten, must not alias the factors.
+	 */
+	static void mulAbs_(const CBigIntDigit* x, size_t x_len, const CBigIntDigit* y, size_t y_len,
+	                    CBigIntDigit* result) {
+		mulKaratsuba_(x, x_len, y, y_len, result, multiply_threads_.load(std::memory_order_relaxed));
+	}
+
+	/**
+	 * @brief Multiply two magnitudes, switching to Karatsuba for large operands.
+	 *
+	 * Unbalanced operands are cut into slices of the shorter length, so the recursion always
+	 * works on halves of similar size. With a thread budget the slices and the three Karatsuba
+	 * subproducts are computed concurrently.
+	 *
+	 * @param x The first factor limbs.
+	 * @param x_len The number of limbs of the first factor.
+	 * @param y The second factor limbs.
+	 * @param y_len The number of limbs of the second factor.
+	 * @param result The x_len + y_len product limbs, overwritten, must not alias the factors.
+	 * @param threads The thread budget.
+	 */
+	static void mulKaratsuba_(const CBigIntDigit* x, size_t x_len, const CBigIntDigit* y, size_t y_len,
+	                          CBigIntDigit* result, size_t threads) {
+		if (x_len < y_len) {
+			std::swap(x, y);
+			std::swap(x_len, y_len);
+		}
+
+		if (y_len < KARATSUBA_THRESHOLD_) {
+			mulSchoolbook_(x, x_len, y, y_len, result);
+			return;
+		}
+
+		if (y_len < parallel_min_limbs_.load(std::memory_order_relaxed))
+			threads = 1;
+
+		if (x_len >= 2 * y_len) {
+			std::fill(result, result + x_len + y_len, 0);
+			size_t slices = (x_len + y_len - 1) / y_len;
+			if (threads > 1) {
+				CBigIntLimbs partials(slices * 2 * y_len);
+				runParallel_(slices, threads, [&](size_t slice, size_t slice_threads) {
+					size_t i = slice * y_len;
+					mulKaratsuba_(x + i, std::min(y_len, x_len - i), y, y_len, partials.data() + 2 * i, slice_threads);
+				});
+				for (size_t i = 0; i < x_len; i += y_len)
+					addInPlace_(result + i, x_len + y_len - i, partials.data() + 2 * i, std::min(y_len, x_len - i) + y_len);
+				return;
+			}
+
+			CBigIntLimbs partial(2 * y_len);
+			for (size_t i = 0; i < x_len; i += y_len) {
+				size_t slice_len = std::min(y_len, x_len - i);
+				mulKaratsuba_(x + i, slice_len, y, y_len, partial.data(), 1);
+				addInPlace_(result + i, x_len + y_len - i, partial.data(), slice_len + y_len);
+			}
+			return;
+		}
+
+		// x = x1 * B^half + x0, y = y1 * B^half + y0, the middle term is (x0 + x1)(y0 + y1) - z0 - z2
+		size_t half = x_len / 2, x_high_len = x_len - half, y_high_len = y_len - half;
+		CBigIntLimbs x_sum(x + half, x + x_len), y_sum;
+		x_sum.push_back(addInPlace_(x_sum.data(), x_high_len, x, half));
+		if (y_high_len >= half) {
+			y_sum.assign(y + half, y + y_len);
+			y_sum.push_back(addInPlace_(y_sum.data(), y_high_len, y, half));
+		} else {
+			y_sum.assign(y, y + half);
+			y_sum.push_back(addInPlace_(y_sum.data(), half, y + half, y_high_len));
+		}
+
+		CBigIntLimbs middle(x_sum.size() + y_sum.size());
+		auto subproduct = [&](size_t index, size_t task_threads) {
+			if (index == 0)
+				mulKaratsuba_(x, half, y, half, result, task_threads);
+			else if (index == 1)
+				mulKaratsuba_(x + half, x_high_len, y + half, y_high_len, result + 2 * half, task_threads);
+			else
+				mulKaratsuba_(x_sum.data(), x_sum.size(), y_sum.data(), y_sum.size(), middle.data(), task_threads);
+		};
+
+		if (threads > 1)
+			runParallel_(3, threads, subproduct);
+		else
+			for (size_t index = 0; index < 3; ++index)
+				subproduct(index, 1);
+		subInPlace_(middle.data(), middle.size(), result, 2 * half);
+		subInPlace_(middle.data(), middle.size(), result + 2 * half, x_high_len + y_high_len);
+		trimLimbs_(middle);
+
+		addInPlace_(result + half, x_len + y_len - half, middle.data(), middle.size());
+	}
+
+	/**
+	 * @brief Multiply two normalized magnitudes.
+	 *
+	 * @param x The first factor limbs.
+	 * @param y The second factor limbs.
+	 * @return The normalized product limbs.
+	 */
+	static CBigIntLimbs mulLimbs_(const CBigIntLimbs& x, const CBigIntLimbs& y) {
+		CBigIntLimbs result(x.size() + y.size());
+		mulAbs_(x.data(), x.size(), y.data(), y.size(), result.data());
+		trimLimbs_(result);
+
+		return result;
+	}
+
+	/**
+	 * @brief Drop the given number of least significant limbs, i.e. floor(x / B^count).
+	 *
+	 * @param x The limbs to shift, updated in place.
+	 * @param count The number of limbs to drop.
+	 */
+	static void shiftDownLimbs_(CBigIntLimbs& x, size_t count) {
+		if (count >= x.size())
+			x.assign(1, 0);
+		else
+			x.erase(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(count));
+	}
+
+	/**
+	 * @brief Divide two magnitudes, using Knuth's algorithm D or a Newton reciprocal for large divisors.
+	 *
+	 * @param x The dividend limbs.
+	 * @param y The non-zero divisor limbs.
+	 * @param quotient The normalized quotient.
+	 * @param remainder The normalized remainder.
+	 */
+	static void divmodAbs_(const CBigIntLimbs& x, const CBigIntLimbs& y,
+	                       CBigIntLimbs& quotient, CBigIntLimbs& remainder) {
+		size_t x_len = x.size(), y_len = y.size();
+		if (compareLimbs_(x, y) < 0) {
+			quotient.assign(1, 0);
+			remainder = x;
+			return;
+		}
+
+		if (y_len == 1) {
+			quotient = x;
+			remainder.assign(1, divSmall_(quotient, y[0]));
+			return;
+		}
+
+		// D1: normalize so that the top divisor limb has its highest bit set
+		unsigned shift = std::countl_zero(y.back());
+		CBigIntLimbs u(x_len + 1), v(y_len);
+		for (size_t i = y_len - 1; i > 0; --i)
+			v[i] = (y[i] << shift) | (shift ? y[i - 1] >> (LIMB_BITS_ - shift) : 0);
+		v[0] = y[0] << shift;
+		u[x_len] = shift ? x[x_len - 1] >> (LIMB_BITS_ - shift) : 0;
+		for (size_t i = x_len - 1; i > 0; --i)
+			u[i] = (x[i] << shift) | (shift ? x[i - 1] >> (LIMB_BITS_ - shift) : 0);
+		u[0] = x[0] << shift;
+
+		if (y_len > NEWTON_THRESHOLD_) {
+			CBigIntLimbs shifted_remainder;
+			trimLimbs_(u);
+			divmodNewton_(u, v, quotient, shifted_remainder);
+			u.assign(y_len + 1, 0);
+			std::copy(shifted_remainder.begin(), shifted_remainder.end(), u.begin());
+		} else
+			divmodKnuth_(u, v, quotient);
+
+		// D8: unnormalize the remainder
+		remainder.assign(y_len, 0);
+		for (size_t i = 0; i < y_len; ++i)
+			remainder[i] = (u[i] >> shift) | (shift ? u[i + 1] << (LIMB_BITS_ - shift) : 0);
+
+		trimLimbs_(quotient);
+		trimLimbs_(remainder);
+	}
+
+	/**
+	 * @brief Main loop of Knuth's algorithm D on already normalized operands.
+	 *
+	 * @param u The normalized dividend of x_len + 1 limbs, replaced by the (still shifted) remainder.
+	 * @param v The normalized divisor of at least two limbs.
+	 * @param quotient The (not normalized) quotient limbs.
+	 */
+	static void divmodKnuth_(CBigIntLimbs& u, const CBigIntLimbs& v,
+	                         CBigIntLimbs& quotient) {
+		size_t x_len = u.size() - 1, y_len = v.size();
+		quotient.assign(x_len - y_len + 1, 0);
+		const CBigIntWideDigit base = CBigIntWideDigit{1} << LIMB_BITS_;
+
+		for (size_t j = x_len - y_len + 1; j-- > 0; ) {
+			// D3: estimate the quotient limb from the top two dividend limbs
+			CBigIntWideDigit numerator = (static_cast<CBigIntWideDigit>(u[j + y_len]) << LIMB_BITS_) | u[j + y_len - 1];
+			CBigIntWideDigit q_hat = numerator / v[y_len - 1], r_hat = numerator % v[y_len - 1];
+			while (q_hat >= base || q_hat * v[y_len - 2] > ((r_hat << LIMB_BITS_) | u[j + y_len - 2])) {
+				--q_hat;
+				r_hat += v[y_len - 1];
+				if (r_hat >= base)
+					break;
+			}
+
+			// D4: multiply and subtract
+			int64_t borrow = 0, diff;
+			for (size_t i = 0; i < y_len; ++i) {
+				CBigIntWideDigit product = q_hat * v[i];
+				diff = static_cast<int64_t>(u[i + j]) - borrow - static_cast<int64_t>(product & 0xFFFFFFFFu);
+				u[i + j] = static_cast<CBigIntDigit>(diff);
+				borrow = static_cast<int64_t>(product >> LIMB_BITS_) - (diff >> LIMB_BITS_);
+			}
+			diff = static_cast<int64_t>(u[j + y_len]) - borrow;
+			u[j + y_len] = static_cast<CBigIntDigit>(diff);
+
+			// D6: the estimate was one too large, add the divisor back
+			if (diff < 0) {
+				--q_hat;
+				CBigIntWideDigit carry = 0;
+				for (size_t i = 0; i < y_len; ++i) {
+					CBigIntWideDigit sum = static_cast<CBigIntWideDigit>(u[i + j]) + v[i] + carry;
+					u[i + j] = static_cast<CBigIntDigit>(sum);
+					carry = sum >> LIMB_BITS_;
+				}
+				u[j + y_len] += static_cast<CBigIntDigit>(carry);
+			}
+
+			quotient[j] = static_cast<CBigIntDigit>(q_hat);
+		}
+	}
+
+	/**
+	 * @brief Compute floor(B^(2n) / v) for a normalized divisor of n limbs.
+	 *
+	 * The reciprocal of the top half of the divisor is refined by a single Newton step,
+	 * the remaining error of a few units is fixed up exactly.
+	 *
+	 * @param v The normalized divisor limbs.
+	 * @return The reciprocal limbs.
+	 */
+	static CBigIntLimbs reciprocal_(const CBigIntLimbs& v) {
+		size_t n = v.size();
+		CBigIntLimbs power(2 * n + 1, 0), reciprocal, remainder;
+		power.back() = 1;
+
+		if (n <= NEWTON_THRESHOLD_) {
+			divmodAbs_(power, v, reciprocal, remainder);
+			return reciprocal;
+		}
+
+		size_t half = n / 2 + 1;
+		reciprocal = reciprocal_(CBigIntLimbs(v.end() - static_cast<std::ptrdiff_t>(half), v.end()));
+		reciprocal.insert(reciprocal.begin(), n - half, 0);
+
+		// r += r * (B^(2n) - v * r) / B^(2n)
+		CBigIntLimbs product = mulLimbs_(v, reciprocal), error;
+		bool is_over = (compareLimbs_(product, power) > 0);
+		is_over ? subAbs_(product, power, error) : subAbs_(power, product, error);
+		CBigIntLimbs correction = mulLimbs_(reciprocal, error);
+		shiftDownLimbs_(correction, 2 * n);
+		if (is_over)
+			subAbs_(reciprocal, correction, reciprocal);
+		else {
+			reciprocal.push_back(0);
+			addInPlace_(reciprocal.data(), reciprocal.size(), correction.data(), correction.size());
+			trimLimbs_(reciprocal);
+		}
+
+		const CBigIntLimbs one{1};
+		product = mulLimbs_(v, reciprocal);
+		while (compareLimbs_(product, power) > 0) {
+			subAbs_(reciprocal, one, reciprocal);
+			subAbs_(product, v, product);
+		}
+		subAbs_(power, product, remainder);
+		while (compareLimbs_(remainder, v) >= 0) {
+			reciprocal.push_back(0);
+			addInPlace_(reciprocal.data(), reciprocal.size(), one.data(), 1);
+			trimLimbs_(reciprocal);
+			subAbs_(remainder, v, remainder);
+		}
+
+		return reciprocal;
+	}
+
+	/**
+	 * @brief Divide by a large normalized divisor using its Newton reciprocal.
+	 *
+	 * The dividend is consumed in blocks of n limbs, each block quotient is estimated by one
+	 * multiplication with the reciprocal and is at most two units too small.
+	 *
+	 * @param u The normalized dividend limbs.
+	 * @param v The normalized divisor of n limbs.
+	 * @param quotient The normalized quotient.
+	 * @param remainder The normalized remainder.
+	 */
+	static void divmodNewton_(const CBigIntLimbs& u, const CBigIntLimbs& v,
+	                          CBigIntLimbs& quotient, CBigIntLimbs& remainder) {
+		size_t n = v.size(), blocks = (u.size() + n - 1) / n;
+		CBigIntLimbs reciprocal = reciprocal_(v), current, estimate;
+		const CBigIntLimbs one{1};
+
+		quotient.assign(blocks * n, 0);
+		remainder.assign(1, 0);
+		for (size_t block = blocks; block-- > 0; ) {
+			size_t offset = block * n, block_len = std::min(n, u.size() - offset);
+			current.assign(u.begin() + static_cast<std::ptrdiff_t>(offset),
+			               u.begin() + static_cast<std::ptrdiff_t>(offset + block_len));
+			current.insert(current.end(), remainder.begin(), remainder.end());
+			trimLimbs_(current);
+
+			estimate = mulLimbs_(current, reciprocal);
+			shiftDownLimbs_(estimate, 2 * n);
+			subAbs_(current, mulLimbs_(estimate, v), remainder);
+			while (compareLimbs_(remainder, v) >= 0) {
+				subAbs_(remainder, v, remainder);
+				estimate.push_back(0);
+				addInPlace_(estimate.data(), estimate.size(), one.data(), 1);
+				trimLimbs_(estimate);
+			}
+
+			std::copy(estimate.begin(), estimate.end(), quotient.begin() + static_cast<std::ptrdiff_t>(offset));
+		}
+
+		trimLimbs_(quotient);
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Get the cached power 10^(9 * 2^level).
+	 *
+	 * @param level The level of the power.
+	 * @return A reference to the power limbs, valid for the program lifetime.
+	 */
+	static const CBigIntLimbs& decimalPower_(size_t level) {
+		static std::deque<CBigIntLimbs> powers{{DECIMAL_CHUNK_BASE_}};
+		static std::mutex powers_mutex;
+
+		std::lock_guard<std::mutex> lock(powers_mutex);
+		while (powers.size() <= level)
+			powers.push_back(mulLimbs_(powers.back(), powers.back()));
+
+		return powers[level];
+	}
+
+	/**
+	 * @brief Convert a string of decimal digits into limbs.
+	 *
+	 * Long inputs are split at 9 * 2^k digits and combined as high * 10^(9 * 2^k) + low.
+	 *
+	 * @param begin The first digit.
+	 * @param end The position past the last digit.
+	 * @param digits The normalized limbs, overwritten, their storage is reused.
+	 */
+	static void parseDecimal_(const char* begin, const char* end, CBigIntLimbs& digits) {
+		size_t len = static_cast<size_t>(end - begin);
+
+		if (len <= DECIMAL_CHUNK_DIGITS_ * RADIX_THRESHOLD_) {
+			digits.assign(1, 0);
+			digits.reserve(len / DECIMAL_CHUNK_DIGITS_ + 1);
+			while (begin != end) {
+				size_t chunk_len = std::min<size_t>(DECIMAL_CHUNK_DIGITS_, static_cast<size_t>(end - begin));
+				CBigIntDigit chunk = 0, chunk_base = 1;
+				for (size_t i = 0; i < chunk_len; ++i, ++begin) {
+					chunk = chunk * 10 + (*begin - ZERO_);
+					chunk_base *= 10;
+				}
+
+				mulAddSmall_(digits, chunk_base, chunk);
+			}
+
+			return;
+		}
+
+		size_t level = 0;
+		while ((DECIMAL_CHUNK_DIGITS_ << (level + 1)) < len)
+			++level;
+
+		const char* split = end - (DECIMAL_CHUNK_DIGITS_ << level);
+		CBigIntLimbs high, low;
+		parseDecimal_(begin, split, high);
+		parseDecimal_(split, end, low);
+
+		// high * 10^k + low < (high + 1) * 10^k, so the sum fits into the product limbs
+		const CBigIntLimbs& power = decimalPower_(level);
+		digits.resize(high.size() + power.size());
+		mulAbs_(high.data(), high.size(), power.data(), power.size(), digits.data());
+		addInPlace_(digits.data(), digits.size(), low.data(), low.size());
+		trimLimbs_(digits);
+	}
+
+	/**
+	 * @brief Append the decimal representation of limbs to a string.
+	 *
+	 * Long inputs are split by the largest cached power of ten not exceeding half their length.
+	 *
+	 * @param x The normalized limbs.
+	 * @param width The exact number of digits to produce (zero padded), 0 for the minimal representation.
+	 * @param out The string to append to.
+	 */
+	static void printDecimal_(const CBigIntLimbs& x, size_t width, std::string& out) {
+		if (x.size() <= RADIX_THRESHOLD_) {
+			CBigIntLimbs chunks, value = x;
+			while (value.size() > 1 || value[0] != 0)
+				chunks.push_back(divSmall_(value, DECIMAL_CHUNK_BASE_));
+
+			std::string str;
+			for (auto chunk_pos = chunks.rbegin(); chunk_pos != chunks.rend(); ++chunk_pos) {
+				std::string chunk = std::to_string(*chunk_pos);
+				if (!str.empty())
+					str.append(DECIMAL_CHUNK_DIGITS_ - chunk.size(), ZERO_);
+				str.append(chunk);
+			}
+
+			if (str.empty() && !width)
+				str.push_back(ZERO_);
+			if (width > str.size())
+				out.append(width - str.size(), ZERO_);
+			out.append(str);
+			return;
+		}
+
+		size_t level = 0;
+		while (decimalPower_(level + 1).size() * 2 <= x.size())
+			++level;
+
+		CBigIntLimbs quotient, remainder;
+		divmodAbs_(x, decimalPower_(level), quotient, remainder);
+
+		size_t low_width = DECIMAL_CHUNK_DIGITS_ << level;
+		printDecimal_(quotient, width ? width - low_width : 0, out);
+		printDecimal_(remainder, low_width, out);
+	}
+
+	/**
+	 * @brief Append the hexadecimal representation of limbs to a string.
+	 *
+	 * @param x The normalized limbs.
+	 * @param is_uppercase True to use upper case hexadecimal digits.
+	 * @param out The string to append to.
+	 */
+	static void printHex_(const CBigIntLimbs& x, bool is_uppercase, std::string& out) {
+		const char* hex_digits = is_uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+		bool is_leading = true;
+		for (auto digit_pos = x.rbegin(); digit_pos != x.rend(); ++digit_pos)
+			for (int shift = LIMB_BITS_ - 4; shift >= 0; shift -= 4) {
+				unsigned nibble = (*digit_pos >> shift) & 0xF;
+				if (is_leading && nibble == 0)
+					continue;
+
+				is_leading = false;
+				out.push_back(hex_digits[nibble]);
+			}
+
+		if (is_leading)
+			out.push_back(ZERO_);
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Montgomery multiplication (CIOS), computes x * y / 2^(32n) mod m.
+	 *
+	 * @param x The first factor, n limbs, less than m.
+	 * @param y The second factor, n limbs, less than m.
+	 * @param m The odd modulus, n limbs.
+	 * @param m_inv The value -m^(-1) mod 2^32.
+	 * @param scratch Scratch buffer of n + 2 limbs.
+	 * @param result The n-limb product, may alias x or y.
+	 */
+	static void montMul_(const CBigIntDigit* x, const CBigIntDigit* y, const CBigIntDigit* m, size_t n,
+	                     CBigIntDigit m_inv, CBigIntDigit* scratch, CBigIntDigit* result) {
+		std::fill(scratch, scratch + n + 2, 0);
+
+		for (size_t i = 0; i < n; ++i) {
+			CBigIntWideDigit carry = 0;
+			for (size_t j = 0; j < n; ++j) {
+				CBigIntWideDigit sum = scratch[j] + static_cast<CBigIntWideDigit>(x[j]) * y[i] + carry;
+				scratch[j] = static_cast<CBigIntDigit>(sum);
+				carry = sum >> LIMB_BITS_;
+			}
+			CBigIntWideDigit sum = scratch[n] + carry;
+			scratch[n] = static_cast<CBigIntDigit>(sum);
+			scratch[n + 1] = static_cast<CBigIntDigit>(sum >> LIMB_BITS_);
+
+			CBigIntDigit factor = scratch[0] * m_inv;
+			carry = (scratch[0] + static_cast<CBigIntWideDigit>(factor) * m[0]) >> LIMB_BITS_;
+			for (size_t j = 1; j < n; ++j) {
+				sum = scratch[j] + static_cast<CBigIntWideDigit>(factor) * m[j] + carry;
+				scratch[j - 1] = static_cast<CBigIntDigit>(sum);
+				carry = sum >> LIMB_BITS_;
+			}
+			sum = scratch[n] + carry;
+			scratch[n - 1] = static_cast<CBigIntDigit>(sum);
+			scratch[n] = scratch[n + 1] + static_cast<CBigIntDigit>(sum >> LIMB_BITS_);
+		}
+
+		bool is_ge_m = (scratch[n] != 0) ||
+		               !std::lexicographical_compare(std::make_reverse_iterator(scratch + n),
+		                                             std::make_reverse_iterator(scratch),
+		                                             std::make_reverse_iterator(m + n),
+		                                             std::make_reverse_iterator(m));
+
+		CBigIntWideDigit borrow = 0;
+		for (size_t i = 0; i < n; ++i) {
+			CBigIntWideDigit sub = static_cast<CBigIntWideDigit>(scratch[i]) - (is_ge_m ? m[i] : 0) - borrow;
+			borrow = (sub >> LIMB_BITS_) & 1;
+			result[i] = static_cast<CBigIntDigit>(sub);
+		}
+	}
+
+	/**
+	 * @brief Modular exponentiation for an odd modulus using Montgomery multiplication.
+	 *
+	 * @param base The reduced base limbs.
+	 * @param exponent The exponent limbs.
+	 * @param m The odd modulus limbs.
+	 * @return The normalized result limbs.
+	 */
+	static CBigIntLimbs powmodMontgomery_(const CBigIntLimbs& base,
+	                                                   const CBigIntLimbs& exponent,
+	                                                   const CBigIntLimbs& m) {
+		size_t n = m.size();
+
+		// Newton iteration doubles the number of correct low bits each round: 1 -> 2 -> ... -> 32
+		CBigIntDigit inv = 1;
+		for (int i = 0; i < 5; ++i)
+			inv *= 2 - m[0] * inv;
+		CBigIntDigit m_inv = 0u - inv;
+
+		// R^2 mod m, where R = 2^(32n), converts operands into the Montgomery domain
+		CBigIntLimbs r_squared(2 * n + 1, 0), q, r2;
+		r_squared.back() = 1;
+		divmodAbs_(r_squared, m, q, r2);
+		r2.resize(n, 0);
+
+		CBigIntLimbs scratch(n + 2), one(n, 0), acc(n, 0), b = base;
+		one[0] = 1;
+		b.resize(n, 0);
+
+		constexpr size_t table_size = size_t{1} << POWMOD_WINDOW_BITS_;
+		std::vector<CBigIntLimbs> table(table_size, CBigIntLimbs(n));
+		montMul_(one.data(), r2.data(), m.data(), n, m_inv, scratch.data(), table[0].data());
+		montMul_(b.data(), r2.data(), m.data(), n, m_inv, scratch.data(), table[1].data());
+		for (size_t i = 2; i < table_size; ++i)
+			montMul_(table[i - 1].data(), table[1].data(), m.data(), n, m_inv, scratch.data(), table[i].data());
+
+		acc = table[0];
+		size_t exponent_bits = exponent.size() * LIMB_BITS_;
+		size_t windows = (exponent_bits + POWMOD_WINDOW_BITS_ - 1) / POWMOD_WINDOW_BITS_;
+		for (size_t w = windows; w-- > 0; ) {
+			for (size_t i = 0; i < POWMOD_WINDOW_BITS_; ++i)
+				montMul_(acc.data(), acc.data(), m.data(), n, m_inv, scratch.data(), acc.data());
+
+			size_t bit_pos = w * POWMOD_WINDOW_BITS_;
+			CBigIntDigit window = (exponent[bit_pos / LIMB_BITS_] >> (bit_pos % LIMB_BITS_)) & (table_size - 1);
+			if (window)
+				montMul_(acc.data(), table[window].data(), m.data(), n, m_inv, scratch.data(), acc.data());
+		}
+
+		montMul_(acc.data(), one.data(), m.data(), n, m_inv, scratch.data(), acc.data());
+		trimLimbs_(acc);
+
+		return acc;
+	}
+
+	/**
+	 * @brief Modular exponentiation by square-and-multiply with full reductions.
+	 *
+	 * @param base The reduced base limbs.
+	 * @param exponent The exponent limbs.
+	 * @param m The modulus limbs.
+	 * @return The normalized result limbs.
+	 */
+	static CBigIntLimbs powmodPlain_(const CBigIntLimbs& base,
+	                                              const CBigIntLimbs& exponent,
+	                                              const CBigIntLimbs& m) {
+		CBigInt acc(1), b;
+		b.digits_ = base;
+		b.sign_ = CBigIntSign::POSITIVE;
+		CBigIntLimbs q;
+
+		for (size_t bit = exponent.size() * LIMB_BITS_; bit-- > 0; ) {
+			acc = acc * acc;
+			divmodAbs_(acc.getDigits(), m, q, acc.digits_);
+			if ((exponent[bit / LIMB_BITS_] >> (bit % LIMB_BITS_)) & 1) {
+				acc = acc * b;
+				divmodAbs_(acc.getDigits(), m, q, acc.digits_);
+			}
+			acc.sign_ = CBigIntSign::POSITIVE;
+		}
+
+		return acc.digits_;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Fixed-width big integer with the given number of bits.
+ *
+ * The value is a two's complement integer of Bits bits kept in a std::array of limbs, so it never
+ * allocates, and the linear loops over the limbs are unrolled at compile time for up to 512 bits.
+ * Addition and multiplication wrap modulo 2^Bits like native integers, and all arithmetic except
+ * division is constexpr.
+ * Values convert explicitly from and to CBigInt, which also provides the decimal and hex text
+ * conversions and the division.
+ *
+ * @tparam Bits The width in bits, a positive multiple of 32.
+ */
+template<size_t Bits>
+class CFixedBigInt {
+public:
+//	--------------------------------------------------------------------------------------------------------------------
+
+	static_assert(Bits > 0 && Bits % 32 == 0, "CFixedBigInt width must be a positive multiple of 32 bits!");
+
+	using CBigIntSign = CBigInt::CBigIntSign;
+	using CBigIntDigit = CBigInt::CBigIntDigit;
+	using CBigIntWideDigit = CBigInt::CBigIntWideDigit;
+
+	static constexpr const size_t LIMBS = Bits / 32;
+
+	using CFixedLimbs = std::array<CBigIntDigit, LIMBS>;
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Default constructor initializing the fixed big integer to zero.
+	 */
+	constexpr CFixedBigInt() : limbs_{} {}
+
+	/**
+	 * @brief Constructor initializing the fixed big integer from a native integer value, sign extended.
+	 *
+	 * @param value Integer value to initialize the fixed big integer.
+	 */
+	template<std::integral T>
+	constexpr explicit CFixedBigInt(T value) : limbs_{} {
+		bool is_negative = false;
+		if constexpr (std::is_signed_v<T>)
+			is_negative = (value < 0);
+		auto bits = static_cast<uint64_t>(static_cast<std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>(value));
+		unroll_([&](size_t i) {
+			limbs_[i] = (i < 2) ? static_cast<CBigIntDigit>(bits >> (LIMB_BITS_ * i)) : (is_negative ? ~CBigIntDigit{0} : 0);
+		});
+	}
+
+	/**
+	 * @brief Constructor initializing the fixed big integer from a CBigInt, reduced modulo 2^Bits.
+	 *
+	 * @param x The CBigInt object to convert.
+	 */
+	explicit CFixedBigInt(const CBigInt& x) : limbs_{} {
+		const auto& digits = x.getDigits();
+		std::copy_n(digits.data(), std::min(digits.size(), LIMBS), limbs_.data());
+		if (x.getSign() == CBigIntSign::NEGATIVE)
+			negate_();
+	}
+
+	/**
+	 * @brief Constructor initializing the fixed big integer from a decimal string, reduced modulo 2^Bits.
+	 *
+	 * @param value The string value to initialize the fixed big integer.
+	 */
+	explicit CFixedBigInt(std::string_view value) : CFixedBigInt(CBigInt(value)) {}
+
+	/**
+	 * @brief Convert to a CBigInt object.
+	 *
+	 * @return The CBigInt object with the same value.
+	 */
+	explicit operator CBigInt() const {
+		CFixedBigInt magnitude = *this;
+		bool is_negative = isNegative_();
+		if (is_negative)
+			magnitude.negate_();
+
+		size_t len = magnitude.significantLimbs_();
+
+		CBigInt result;
+		if (len == 1 && magnitude.limbs_[0] == 0)
+			return result;
+
+		result.sign_ = is_negative ? CBigIntSign::NEGATIVE : CBigIntSign::POSITIVE;
+		result.digits_.assign(magnitude.limbs_.data(), magnitude.limbs_.data() + len);
+
+		return result;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Get the sign of the fixed big integer.
+	 *
+	 * @return The sign of the fixed big integer.
+	 */
+	[[nodiscard]] constexpr CBigIntSign getSign() const {
+		if (isNegative_())
+			return CBigIntSign::NEGATIVE;
+
+		bool is_zero = true;
+		unroll_([&](size_t i) { is_zero &= (limbs_[i] == 0); });
+
+		return is_zero ? CBigIntSign::ZERO : CBigIntSign::POSITIVE;
+	}
+
+	/**
+	 * @brief Get the limbs of the fixed big integer.
+	 *
+	 * @return A reference to the two's complement limbs, least significant limb first.
+	 */
+	[[nodiscard]] constexpr const CFixedLimbs& getLimbs() const {
+		return limbs_;
+	}
+
+//	--------------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Addition operator for two CFixedBigInt objects, wrapping modulo 2^Bits.
+	 *
+	 * @param x The first CFixedBigInt object.
+	 * @param y The second CFixedBigInt object.
+	 * @return The sum of the two CFixedBigInt objects.
+	 */
+	friend constexpr CFixedBigInt operator+(CFixedBigInt x, const CFixedBigInt& y) {
+		return x += y;
+	}
+
+	/**
+	 * @brief Addition assignment operator for two CFixedBigInt objects, wrapping modulo 2^Bits.
+	 *
+	 * @param x The CFixedBigInt object to add to.
+	 * @param y The CFixedBigInt object to add.
+	 * @return A reference to the updated CFixedBigInt object.
+	 */
+	friend constexpr CFixedBigInt& operator+=(CFixedBigInt& x, const CFixedBigInt& y) {
+		CBigIntWideDigit carry = 0;
+		unroll_([&](size_t i) {
+			carry += static_cast<CBigIntWideDigit>(x.limbs_[i]) + y.limbs_[i];
+			x.limbs_[i] = static_cast<CBigIntDigit>(carry);
+			carry >>= LIMB_BITS_;
+		});
+
+		return x;
+	}
+
+	/**
+	 * @brief Multiplication operator for two CFixedBigInt objects, wrapping modulo 2^Bits.
+	 *
+	 * Only the partial products below 2^Bits are computed and the zero top limbs of both factors are
+	 * skipped, so short values in a wide type do not pay for the full width. The quadratic loop is
+	 * left to the compiler rather than unrolled, which would bloat wide types.
+	 *
+	 * @param x The first CFixedBigInt object.
+	 * @param y The second CFixedBigInt object.
+	 * @return The product of the two CFixedBigInt objects.
+	 */
+	friend constexpr CFixedBigInt operator*(const CFixedBigInt& x, const CFixedBigInt& y) {
+		size_t x_len = x.significantLimbs_(), y_len = y.significantLimbs_();
+
+		CFixedBigInt result;
+		for (size_t i = 0; i < x_len; ++i) {
+			CBigIntWideDigit carry = 0;
+			size_t row_len = std::min(y_len, LIMBS - i);
+			for (size_t j = 0; j < row_len; ++j) {
+				carry += result.limbs_[i + j] + static_cast<CBigIntWideDigit>(x.limbs_[i]) * y.limbs_[j];
+				result.limbs_[i + j] = static_cast<CBigIntDigit>(carry);
+				carry >>= LIMB_BITS_;
+			}
+			if (i + row_len < LIMBS)
+				result.limbs_[i + row_len] = static_cast<CBigIntDigit>(carry);
+		}
+
+		return result;
 	}
 
 	/**
-	 * @brief Templated less than operator for CBigInt and another type.
+	 * @brief Multiplication assignment operator for two CFixedBigInt objects, wrapping modulo 2^Bits.
 	 *
-	 * @param x The CBigInt object.
-	 * @param y The value to compare.
-	 * @return True if the CBigInt object is less than the value, false otherwise.
+	 * @param x The CFixedBigInt object to multiply.
+	 * @param y The CFixedBigInt object to multiply by.
+	 * @return A reference to the updated CFixedBigInt object.
 	 */
-	template<typename T>
-	friend bool operator<(const CBigInt& x, const T& y) {
-		return x < CBigInt(y);
+	friend constexpr CFixedBigInt& operator*=(CFixedBigInt& x, const CFixedBigInt& y) {
+		return x = x * y;
 	}
 
 	/**
-	 * @brief Templated less than operator for another type and CBigInt.
-	 *
-	 * @param x The value to compare.
-	 * @param y The CBigInt object.
-	 * @return True if the value is less than the CBigInt object, false otherwise.
+	 * @brief Addition operator for CFixedBigInt and a native integer, wrapping modulo 2^Bits.
 	 */
-	template<typename T>
-	friend bool operator<(const T& x, const CBigInt& y) {
-		return CBigInt(x) < y;
+	template<std::integral T>
+	friend constexpr CFixedBigInt operator+(CFixedBigInt x, T y) {
+		return x += CFixedBigInt(y);
 	}
 
-//	--------------------------------------------------------------------------------------------------------------------
-
 	/**
-	 * @brief Less than or equal to operator for two CBigInt objects.
-	 *
-	 * @param x The first CBigInt object.
-	 * @param y The second CBigInt object.
-	 * @return True if the first CBigInt object is less than or equal to the second, false otherwise.
+	 * @brief Addition operator for a native integer and CFixedBigInt, wrapping modulo 2^Bits.
 	 */
-	friend bool operator<=(const CBigInt& x, const CBigInt& y) {
-		return (x < y) || (x == y);
+	template<std::integral T>
+	friend constexpr CFixedBigInt operator+(T x, CFixedBigInt y) {
+		return y += CFixedBigInt(x);
 	}
 
 	/**
-	 * @brief Templated less than or equal to operator for CBigInt and another type.
-	 *
-	 * @param x The CBigInt object.
-	 * @param y The value to compare.
-	 * @return True if the CBigInt object is less than or equal to the value, false otherwise.
+	 * @brief Addition assignment operator for CFixedBigInt and a native integer, wrapping modulo 2^Bits.
 	 */
-	template<typename T>
-	friend bool operator<=(const CBigInt& x, const T& y) {
-		return x <= CBigInt(y);
+	template<std::integral T>
+	friend constexpr CFixedBigInt& operator+=(CFixedBigInt& x, T y) {
+		return x += CFixedBigInt(y);
 	}
 
 	/**
-	 * @brief Templated less than or equal to operator for another type and CBigInt.
-	 *
-	 * @param x The value to compare.
-	 * @param y The CBigInt object.
-	 * @return True if the value is less than or equal to the CBigInt object, false otherwise.
+	 * @brief Multiplication operator for CFixedBigInt and a native integer, wrapping modulo 2^Bits.
 	 */
-	template<typename T>
-	friend bool operator<=(const T& x, const CBigInt& y) {
-		return CBigInt(x) <= y;
+	template<std::integral T>
+	friend constexpr CFixedBigInt operator*(const CFixedBigInt& x, T y) {
+		return x * CFixedBigInt(y);
 	}
 
-//	--------------------------------------------------------------------------------------------------------------------
+	/**
+	 * @brief Multiplication operator for a native integer and CFixedBigInt, wrapping modulo 2^Bits.
+	 */
+	template<std::integral T>
+	friend constexpr CFixedBigInt operator*(T x, const CFixedBigInt& y) {
+		return CFixedBigInt(x) * y;
+	}
 
 	/**
-	 * @brief Greater than operator for two CBigInt objects.
-	 *
-	 * @param x The first CBigInt object.
-	 * @param y The second CBigInt object.
-	 * @return True if the first CBigInt object is greater than the second, false otherwise.
+	 * @brief Multiplication assignment operator for CFixedBigInt and a native integer, wrapping modulo 2^Bits.
 	 */
-	friend bool operator>(const CBigInt& x, const CBigInt& y) {
-		return y < x;
+	template<std::integral T>
+	friend constexpr CFixedBigInt& operator*=(CFixedBigInt& x, T y) {
+		return x = x * CFixedBigInt(y);
 	}
+
 	/**
-	* @brief Templated greater than operator for CBigInt and another type.
-	*
-	* @param x The CBigInt object
-	* @param y The value to compare.
-	* @return True if the CBigInt object is greater than the value, false otherwise.
-	*/
-	template<typename T>
-	friend bool operator>(const CBigInt& x, const T& y) {
-		return CBigInt(y) < x;
+	 * @brief Division operator truncating toward zero, computed through CBigInt.
+	 *
+	 * @param x The dividend.
+	 * @param y The divisor.
+	 * @return The quotient, wrapping modulo 2^Bits.
+	 * @throws std::invalid_argument If the divisor is zero.
+	 */
+	friend CFixedBigInt operator/(const CFixedBigInt& x, const CFixedBigInt& y) {
+		return CFixedBigInt(CBigInt(x) / CBigInt(y));
 	}
 
 	/**
-	 * @brief Templated greater than operator for another type and CBigInt.
+	 * @brief Modulo operator, the remainder takes the sign of the dividend, computed through CBigInt.
 	 *
-	 * @param x The value to compare.
-	 * @param y The CBigInt object.
-	 * @return True if the value is greater than the CBigInt object, false otherwise.
+	 * @param x The dividend.
+	 * @param y The divisor.
+	 * @return The remainder.
+	 * @throws std::invalid_argument If the divisor is zero.
 	 */
-	template<typename T>
-	friend bool operator>(const T& x, const CBigInt& y) {
-		return y < CBigInt(x);
+	friend CFixedBigInt operator%(const CFixedBigInt& x, const CFixedBigInt& y) {
+		return CFixedBigInt(CBigInt(x) % CBigInt(y));
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
 
 	/**
-	 * @brief Greater than or equal to operator for two CBigInt objects.
+	 * @brief Equality operator for two CFixedBigInt objects.
+	 */
+	friend constexpr bool operator==(const CFixedBigInt& x, const CFixedBigInt& y) = default;
+
+	/**
+	 * @brief Three-way comparison of two CFixedBigInt objects as signed integers.
 	 *
-	 * @param x The first CBigInt object.
-	 * @param y The second CBigInt object.
-	 * @return True if the first CBigInt object is greater than or equal to the second, false otherwise.
+	 * @param x The first CFixedBigInt object.
+	 * @param y The second CFixedBigInt object.
+	 * @return The ordering of x relative to y.
 	 */
-	friend bool operator>=(const CBigInt& x, const CBigInt& y) {
-		return (x > y) || (x == y);
+	friend constexpr std::strong_ordering operator<=>(const CFixedBigInt& x, const CFixedBigInt& y) {
+		if (x.isNegative_() != y.isNegative_())
+			return x.isNegative_() ? std::strong_ordering::less : std::strong_ordering::greater;
+
+		std::strong_ordering ordering = std::strong_ordering::equal;
+		unroll_([&](size_t i) {
+			if (x.limbs_[i] != y.limbs_[i])
+				ordering = x.limbs_[i] <=> y.limbs_[i];
+		});
+
+		return ordering;
 	}
 
 	/**
-	 * @brief Templated greater than or equal to operator for CBigInt and another type.
-	 *
-	 * @param x The CBigInt object.
-	 * @param y The value to compare.
-	 * @return True if the CBigInt object is greater than or equal to the value, false otherwise.
+	 * @brief Equality operator for CFixedBigInt and a native integer.
 	 */
-	template<typename T>
-	friend bool operator>=(const CBigInt& x, const T& y) {
-		return x >= CBigInt(y);
+	template<std::integral T>
+	friend constexpr bool operator==(const CFixedBigInt& x, T y) {
+		return x == CFixedBigInt(y);
 	}
 
 	/**
-	 * @brief Templated greater than or equal to operator for another type and CBigInt.
-	 *
-	 * @param x The value to compare.
-	 * @param y The CBigInt object.
-	 * @return True if the value is greater than or equal to the CBigInt object, false otherwise.
+	 * @brief Three-way comparison of CFixedBigInt and a native integer.
 	 */
-	template<typename T>
-	friend bool operator>=(const T& x, const CBigInt& y) {
-		return CBigInt(x) >= y;
+	template<std::integral T>
+	friend constexpr std::strong_ordering operator<=>(const CFixedBigInt& x, T y) {
+		return x <=> CFixedBigInt(y);
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
 
 	/**
-	 * @brief Output stream operator for CBigInt.
+	 * @brief Output stream operator, with the same formatting as CBigInt.
 	 *
 	 * @param os The output stream.
-	 * @param x The CBigInt object to output.
+	 * @param x The CFixedBigInt object to output.
 	 * @return A reference to the output stream.
 	 */
-	friend std::ostream& operator<<(std::ostream& os, const CBigInt& x) {
-		bool is_negative = (x.sign_ == CBigIntSign::NEGATIVE);
-		if (is_negative)
-			os << MINUS_;
-
-		auto start_pos = x.getDigits().rbegin(), end_pos = x.getDigits().rend();
-		for (auto digit_pos = start_pos; digit_pos != end_pos; ++digit_pos)
-			os << *digit_pos;
-
-		return os;
+	friend std::ostream& operator<<(std::ostream& os, const CFixedBigInt& x) {
+		return os << CBigInt(x);
 	}
 
 	/**
-	 * @brief Input stream operator for CBigInt.
+	 * @brief Input stream operator, the value is reduced modulo 2^Bits.
 	 *
 	 * @param is The input stream.
-	 * @param x The CBigInt object to input.
+	 * @param x The CFixedBigInt object to input.
 	 * @return A reference to the input stream.
 	 */
-	friend std::istream& operator>>(std::istream& is, CBigInt& x) {
-		std::string value;
-		char c;
-
-		while (std::isspace(is.peek()))
-			is.get();
-
-		if (is.peek() == MINUS_) {
-			is.get(c);
-			value.push_back(c);
-		}
-
-		bool is_valid = false;
-		while (std::isdigit(is.peek())) {
-			is_valid = true;
-			is.get(c);
-			value.push_back(c);
-		}
-
-		if (is_valid)
-			x = CBigInt(value);
-		else
-			is.setstate(std::ios::failbit);
+	friend std::istream& operator>>(std::istream& is, CFixedBigInt& x) {
+		CBigInt value;
+		if (is >> value)
+			x = CFixedBigInt(value);
 
 		return is;
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
+
 private:
 //	--------------------------------------------------------------------------------------------------------------------
 
-	static constexpr const char MINUS_ = '-', ZERO_ = '0';
-
-//	--------------------------------------------------------------------------------------------------------------------
+	static constexpr const unsigned LIMB_BITS_ = 32;
+	static constexpr const size_t UNROLL_LIMBS_ = 16;
 
-	CBigIntSign sign_;
-	std::vector<CBigIntDigit> digits_;
+	CFixedLimbs limbs_;
 
 //	--------------------------------------------------------------------------------------------------------------------
 
 	/**
-	 * @brief Normalize the string input to remove leading zeros and whitespaces.
+	 * @brief Call a function for every limb index, unrolled at compile time up to UNROLL_LIMBS_ limbs.
 	 *
-	 * @param value The string value to normalize.
-	 * @return The normalized string value.
+	 * Wider types use a plain loop, GCC stops inlining the unrolled calls beyond that size.
+	 *
+	 * @param f The function taking the limb index.
 	 */
-	static std::string normalizeStringInput_(const std::string& value) {
-		auto start_pos = value.begin(), end_pos = value.end();
-
-		auto end_whitespace_pos = std::find_if(start_pos, end_pos,
-		                                       [](unsigned char c) { return !std::isspace(c); });
-		bool is_negative = (end_whitespace_pos != end_pos && *end_whitespace_pos == MINUS_);
-		end_whitespace_pos = (is_negative) ? ++end_whitespace_pos : end_whitespace_pos;
-
-		bool is_not_empty = (end_whitespace_pos != end_pos);
-		auto end_zero_pos = std::find_if(end_whitespace_pos, end_pos,
-		                                 [](unsigned char c) { return c != ZERO_; });
-		bool is_zero = (end_zero_pos == end_pos);
-
-		return ((is_negative) ? std::string{MINUS_} : std::string{}) +
-		       ((is_not_empty && is_zero) ? std::string{ZERO_} : std::string{end_zero_pos, end_pos});
+	template<typename F>
+	static constexpr void unroll_(F&& f) {
+		if constexpr (LIMBS <= UNROLL_LIMBS_)
+			[&]<size_t... I>(std::index_sequence<I...>) {
+				(f(I), ...);
+			}(std::make_index_sequence<LIMBS>{});
+		else
+			for (size_t i = 0; i < LIMBS; ++i)
+				f(i);
 	}
 
-//	--------------------------------------------------------------------------------------------------------------------
-
 	/**
-	 * @brief Normalize the digits vector by removing leading zeros.
+	 * @brief Check the two's complement sign bit.
 	 *
-	 * @param x The CBigInt object to normalize.
+	 * @return True if the value is negative.
 	 */
-	static void normalizeDigits_(CBigInt& x) {
-		while ((x.digits_.size() > 1) && (x.digits_.back() == 0))
-			x.digits_.pop_back();
+	[[nodiscard]] constexpr bool isNegative_() const {
+		return (limbs_[LIMBS - 1] >> (LIMB_BITS_ - 1)) != 0;
 	}
 
-//	--------------------------------------------------------------------------------------------------------------------
-
 	/**
-	 * @brief Compare the absolute values of two CBigInt objects.
+	 * @brief Count the limbs up to the most significant non-zero one.
 	 *
-	 * @param x The first CBigInt object.
-	 * @param y The second CBigInt object.
-	 * @return -1 if x < y, 0 if x == y, 1 if x > y.
+	 * @return The number of significant limbs, at least one.
 	 */
-	static int compareAbs_(const CBigInt& x, const CBigInt& y) {
-		size_t x_len = x.getDigits().size(), y_len = y.getDigits().size();
-
-		bool is_ne_len = (x_len != y_len);
-		if (is_ne_len)
-			return (x_len < y_len) ? -1 : 1;
+	[[nodiscard]] constexpr size_t significantLimbs_() const {
+		size_t len = LIMBS;
+		while (len > 1 && limbs_[len - 1] == 0)
+			--len;
 
-		for (int i = static_cast<int>(x_len) - 1; i >= 0; --i) {
-			bool is_ne_digit = (x.getDigits()[i] != y.getDigits()[i]);
-			if (is_ne_digit)
-				return (x.getDigits()[i] < y.getDigits()[i]) ? -1 : 1;
-		}
+		return len;
+	}
 
-		return 0;
+	/**
+	 * @brief Negate in place, x = 2^Bits - x.
+	 */
+	constexpr void negate_() {
+		CBigIntWideDigit carry = 1;
+		unroll_([&](size_t i) {
+			carry += static_cast<CBigIntDigit>(~limbs_[i]);
+			limbs_[i] = static_cast<CBigIntDigit>(carry);
+			carry >>= LIMB_BITS_;
+		});
 	}
 
 //	--------------------------------------------------------------------------------------------------------------------
@@ -715,13 +3192,400 @@ static bool equal(const CBigInt& x, const char val[]) {
 // ---------------------------------------------------------------------------------------------------------------------
 
 static bool equalHex(const CBigInt& x, const char val[]) {
-	return true; // hex output is needed for bonus tests only
-	// std::ostringstream oss;
-	// oss << std::hex << x;
+	std::ostringstream oss;
+	oss << std::hex << x;
+
+	return oss . str () == val;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#ifdef BENCHMARK
+
+static std::atomic<size_t> g_allocation_count = 0;
+
+void* operator new(size_t size) {
+	g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+// kept out of line, so GCC does not pair the inlined free with a new expression
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+/**
+ * @brief Build a uniformly random CBigInt with exactly the given number of bits.
+ *
+ * @param bits The bit length, a multiple of 16.
+ * @param rng The random generator.
+ * @return The random CBigInt object with the top and bottom bits set.
+ */
+static CBigInt randomBigInt(size_t bits, std::mt19937& rng) {
+	CBigInt x;
+	for (size_t i = 0; i < bits / 16; ++i) {
+		int chunk = static_cast<int>(rng() & 0xFFFF) | ((i == 0) ? 0x8000 : 0) | ((i + 1 == bits / 16) ? 1 : 0);
+		x = x * 65536 + chunk;
+	}
+
+	return x;
+}
+
+/**
+ * @brief Measure the throughput of RSA-sized modular exponentiation.
+ */
+static void benchmarkPowmod() {
+	std::mt19937 rng(2024);
+
+	for (size_t bits : {2048, 4096}) {
+		CBigInt modulus = randomBigInt(bits, rng), base = randomBigInt(bits - 16, rng),
+		        exponent = randomBigInt(bits, rng), result;
+		size_t rounds = (bits == 2048) ? 20 : 5;
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < rounds; ++i)
+			result = powmod(base, exponent, modulus);
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "powmod " << bits << "-bit: " << elapsed.count() / rounds << " ms/op" << std::endl;
+	}
+}
+
+/**
+ * @brief Measure decimal parsing and printing, and hexadecimal printing of huge numbers.
+ */
+static void benchmarkConversion() {
+	std::mt19937 rng(2024);
+
+	for (size_t digits : {10000, 100000, 1000000}) {
+		std::string str(digits, '0');
+		for (auto& c : str)
+			c = static_cast<char>('0' + rng() % 10);
+		str[0] = '7';
+
+		auto start = std::chrono::steady_clock::now();
+		CBigInt x(str);
+		auto parsed = std::chrono::steady_clock::now();
+		std::ostringstream oss;
+		oss << x;
+		auto printed = std::chrono::steady_clock::now();
+		std::ostringstream oss_hex;
+		oss_hex << std::hex << x;
+		auto printed_hex = std::chrono::steady_clock::now();
+
+		assert ( oss . str () == str );
+		std::chrono::duration<double, std::milli> parse_time = parsed - start, print_time = printed - parsed,
+		                                          hex_time = printed_hex - printed;
+		std::cout << "conversion " << digits << " digits: parse " << parse_time.count() << " ms, print "
+		          << print_time.count() << " ms, hex " << hex_time.count() << " ms" << std::endl;
+	}
+}
 
-	// return oss . str () == val;
+/**
+ * @brief Count heap allocations of typical small-value workloads that fit into 128 bits.
+ */
+static void benchmarkAllocations() {
+	constexpr size_t rounds = 1000000;
+
+	auto measure = [](const char* name, auto&& workload) {
+		size_t allocations = g_allocation_count;
+		auto start = std::chrono::steady_clock::now();
+		workload();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "allocations " << name << ": " << (g_allocation_count - allocations) << " allocs, "
+		          << elapsed.count() / rounds << " ns/op" << std::endl;
+	};
+
+	CBigInt total, amount("18446744073709551557"), checksum;
+	measure("ledger +=", [&]() {
+		for (size_t i = 0; i < rounds; ++i)
+			total += static_cast<int64_t>(i * 7919);
+	});
+	measure("ledger + (temporaries)", [&]() {
+		for (size_t i = 0; i < rounds; ++i)
+			total = total + amount + static_cast<int>(i);
+	});
+	measure("scale *= and compare", [&]() {
+		for (size_t i = 0; i < rounds; ++i) {
+			checksum = amount;
+			checksum *= static_cast<int>(i & 0xFFFF);
+			if (checksum > total)
+				checksum += -1;
+		}
+	});
+}
+
+/**
+ * @brief Compare fused expression evaluation with eagerly materialized temporaries on polynomial evaluation.
+ */
+static void benchmarkPolynomial() {
+	std::mt19937 rng(29);
+
+	for (size_t bits : {256, 2048, 16384}) {
+		size_t rounds = 4000000 / bits;
+		CBigInt x = randomBigInt(bits, rng), c0 = randomBigInt(4 * bits, rng), c1 = randomBigInt(3 * bits, rng),
+				c2 = randomBigInt(2 * bits, rng), c3 = randomBigInt(bits, rng), c4 = randomBigInt(bits / 2, rng);
+		CBigInt x2 = CBigInt(x * x), x3 = CBigInt(x2 * x), x4 = CBigInt(x3 * x);
+		CBigInt fused, eager;
+
+		auto measure = [&](const char* name, auto&& workload) {
+			size_t allocations = g_allocation_count;
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < rounds; ++i)
+				workload();
+			std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+			std::cout << "polynomial " << bits << " bits " << name << ": " << elapsed.count() / rounds << " us/op, "
+			          << static_cast<double>(g_allocation_count - allocations) / rounds << " allocs/op" << std::endl;
+		};
+
+		measure("fused", [&]() {
+			fused = c0 + c1 * x + c2 * x2 + c3 * x3 + c4 * x4;
+		});
+		measure("eager", [&]() {
+			CBigInt t1 = c1 * x, t2 = c2 * x2, t3 = c3 * x3, t4 = c4 * x4;
+			eager = c0 + t1 + t2 + t3 + t4;
+		});
+		measure("horner", [&]() {
+			eager = c4;
+			eager = eager * x + c3;
+			eager = eager * x + c2;
+			eager = eager * x + c1;
+			eager = eager * x + c0;
+		});
+
+		assert ( fused == eager );
+	}
+}
+
+/**
+ * @brief Measure the scaling of multi-threaded multiplication of million-digit operands.
+ */
+static void benchmarkParallelMultiply() {
+	std::mt19937 rng(30);
+	auto randomDecimal = [&](size_t digits) {
+		std::string str(digits, '0');
+		for (char& digit : str)
+			digit = static_cast<char>('0' + rng() % 10);
+		str[0] = '7';
+		return CBigInt(str);
+	};
+
+	CBigInt x = randomDecimal(1000000), y = randomDecimal(1000000), expected = x * y;
+
+	for (size_t threads : {1, 2, 4, 8, 16}) {
+		CBigInt::setMultiplyThreads(threads);
+		auto start = std::chrono::steady_clock::now();
+		CBigInt product = x * y;
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		assert ( product == expected );
+		std::cout << "multiply 1M digits, " << threads << " threads: " << elapsed.count() << " ms" << std::endl;
+	}
+
+	CBigInt::setMultiplyThreads(1);
+}
+
+/**
+ * @brief Build a random CBigInt with about the given number of limbs as a product of random halves.
+ *
+ * @param limbs The number of limbs.
+ * @param rng The random generator.
+ * @return The random CBigInt object.
+ */
+static CBigInt randomLimbs(size_t limbs, std::mt19937& rng) {
+	if (limbs <= 64)
+		return randomBigInt(limbs * 32, rng);
+
+	return randomLimbs(limbs / 2, rng) * randomLimbs(limbs - limbs / 2, rng);
+}
+
+/**
+ * @brief Compare the vectorized and the portable add, subtract and compare kernels on 1k-1M limb operands.
+ */
+static void benchmarkLimbKernels() {
+	std::mt19937 rng(31);
+
+	for (size_t limbs : {1000, 10000, 100000, 1000000}) {
+		CBigInt x = randomLimbs(limbs, rng), y = randomLimbs(limbs, rng), y_negative = y * -1, x_copy = x;
+		size_t rounds = std::max<size_t>(20000000 / limbs, 10);
+
+		for (bool is_simd : {false, true}) {
+			CBigInt::setSimdKernels(is_simd);
+			const char* kernel = is_simd ? "simd" : "portable";
+
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < rounds; ++i) {
+				x += y;
+				x += y_negative;
+			}
+			std::chrono::duration<double, std::nano> add_sub = std::chrono::steady_clock::now() - start;
+
+			start = std::chrono::steady_clock::now();
+			size_t smaller = 0;
+			for (size_t i = 0; i < rounds; ++i)
+				smaller += (x < x_copy);
+			std::chrono::duration<double, std::nano> compare = std::chrono::steady_clock::now() - start;
+
+			assert ( x == x_copy && smaller == 0 );
+			std::cout << "limb kernels " << x.getDigits().size() << " limbs " << kernel << ": add+sub "
+			          << add_sub.count() / rounds << " ns, compare " << compare.count() / rounds << " ns" << std::endl;
+		}
+	}
+
+	CBigInt::setSimdKernels(true);
+}
+
+/**
+ * @brief Measure assignment and construction from const char*, std::string and int64_t.
+ */
+static void benchmarkParse() {
+	constexpr size_t rounds = 1000000;
+	const char* literal = "-12345678901234567890123456789";
+	std::string str(literal), long_str(1000, '7');
+	CBigInt x;
+	size_t checksum = 0;
+
+	auto measure = [&](const char* name, size_t count, auto&& workload) {
+		size_t allocations = g_allocation_count;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < count; ++i)
+			workload(i);
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "parse " << name << ": " << elapsed.count() / count << " ns/op, "
+		          << static_cast<double>(g_allocation_count - allocations) / count << " allocs/op" << std::endl;
+	};
+
+	measure("assign const char*", rounds, [&](size_t) {
+		x = literal;
+	});
+	measure("assign std::string", rounds, [&](size_t) {
+		x = str;
+	});
+	measure("assign int64_t", rounds, [&](size_t i) {
+		x = static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL);
+	});
+	measure("construct const char*", rounds, [&](size_t) {
+		checksum += CBigInt(literal).getDigits().size();
+	});
+	measure("construct std::string", rounds, [&](size_t) {
+		checksum += CBigInt(str).getDigits().size();
+	});
+	measure("from_chars", rounds, [&](size_t) {
+		from_chars(str.data(), str.data() + str.size(), x);
+	});
+	measure("assign 1000 digits", rounds / 100, [&](size_t) {
+		x = long_str;
+	});
+
+	assert ( checksum == 2 * rounds * CBigInt(str).getDigits().size() );
+}
+
+/**
+ * @brief Compare CFixedBigInt with CBigInt on full-width products, sums and comparisons.
+ *
+ * @tparam Bits The width of the operands in bits.
+ */
+template<size_t Bits>
+static void benchmarkFixedWidth() {
+	constexpr size_t rounds = 1000000;
+	std::mt19937 rng(33);
+	// keep x * y + z below 2^(Bits - 1), so both types compute the same value
+	CBigInt x = randomBigInt(Bits / 2 - 16, rng), y = randomBigInt(Bits / 2, rng), z = randomBigInt(Bits - 32, rng);
+	CFixedBigInt<Bits> fixed_x(x), fixed_y(y), fixed_z(z);
+
+	auto measure = [&](const char* name, auto&& workload) {
+		size_t allocations = g_allocation_count;
+		auto start = std::chrono::steady_clock::now();
+		size_t checksum = 0;
+		for (size_t i = 0; i < rounds; ++i)
+			checksum += workload();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "fixed width " << Bits << " bits " << name << ": " << elapsed.count() / rounds << " ns/op, "
+		          << static_cast<double>(g_allocation_count - allocations) / rounds << " allocs/op" << std::endl;
+		return checksum;
+	};
+
+	CBigInt product;
+	CFixedBigInt<Bits> fixed_product;
+	size_t dynamic_checksum = measure("CBigInt", [&]() {
+		product = x * y;
+		product += z;
+		return static_cast<size_t>(product > z);
+	});
+	size_t fixed_checksum = measure("CFixedBigInt", [&]() {
+		fixed_product = fixed_x * fixed_y;
+		fixed_product += fixed_z;
+		return static_cast<size_t>(fixed_product > fixed_z);
+	});
+
+	assert ( dynamic_checksum == fixed_checksum && CFixedBigInt<Bits>(product) == fixed_product );
+}
+
+/**
+ * @brief Compare the batch APIs with per-element loops on a ledger of 256-bit amounts.
+ */
+static void benchmarkBatch() {
+	constexpr size_t count = 200000;
+	std::mt19937 rng(34);
+	std::vector<CBigInt> x(count), y(count), result(count);
+	for (size_t i = 0; i < count; ++i) {
+		x[i] = randomBigInt(256, rng);
+		y[i] = randomBigInt(224, rng) * ((i % 3 == 0) ? -1 : 1);
+	}
+
+	auto measure = [&](const char* name, auto&& workload) {
+		size_t allocations = g_allocation_count;
+		auto start = std::chrono::steady_clock::now();
+		CBigInt value = workload();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "batch " << count << " x 256 bits " << name << ": " << elapsed.count() / count << " ns/element, "
+		          << static_cast<double>(g_allocation_count - allocations) / count << " allocs/element" << std::endl;
+		return value;
+	};
+
+	measure("add loop", [&]() {
+		for (size_t i = 0; i < count; ++i)
+			result[i] = x[i] + y[i];
+		return result[0];
+	});
+	CBigInt expected = measure("sum loop", [&]() {
+		CBigInt total;
+		for (const CBigInt& value : y)
+			total += value;
+		return total;
+	});
+	CBigInt expected_dot = measure("dot loop", [&]() {
+		CBigInt total;
+		for (size_t i = 0; i < count; ++i)
+			total = total + x[i] * y[i];
+		return total;
+	});
+
+	for (size_t threads : {1, 4}) {
+		std::string suffix = ", " + std::to_string(threads) + " threads";
+		measure(("addMany" + suffix).c_str(), [&]() {
+			CBigInt::addMany(x, y, result, threads);
+			return result[0];
+		});
+		assert ( measure(("sum" + suffix).c_str(), [&]() { return CBigInt::sum(y, threads); }) == expected );
+		assert ( measure(("dot" + suffix).c_str(), [&]() { return CBigInt::dot(x, y, threads); }) == expected_dot );
+	}
 }
 
+#endif /* BENCHMARK */
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -829,5 +3693,180 @@ int main() {
     assert ( ! ( a == -87654321 ) );
     assert ( a != -87654321 );
 
+	a = "-4761556948575111126880627366067073182286";
+	assert ( equal ( a / "54321987654321987654", "-87654321098765432109" ) );
+	assert ( equal ( a % "54321987654321987654", "0" ) );
+	a = "340282366920938463463374607431768211457";
+	assert ( equal ( a / "4294967297", "79228162495817593524129366015" ) );
+	assert ( equal ( a % "4294967297", "2" ) );
+	a = -7;
+	assert ( equal ( a / 2, "-3" ) );
+	assert ( equal ( a % 2, "-1" ) );
+	a /= -2;
+	assert ( equal ( a, "3" ) );
+	a %= 2;
+	assert ( equal ( a, "1" ) );
+	try {
+		a = a / 0;
+		assert ( "missing an exception" == nullptr );
+	} catch ( const std::invalid_argument & e ) {
+		assert ( equal ( a, "1" ) );
+	}
+
+	assert ( equal ( powmod ( CBigInt ( 4 ), CBigInt ( 13 ), CBigInt ( 497 ) ), "445" ) );
+	assert ( equal ( powmod ( CBigInt ( -7 ), CBigInt ( 3 ), CBigInt ( 10 ) ), "7" ) );
+	assert ( equal ( powmod ( CBigInt ( 3 ), CBigInt ( 200 ), CBigInt ( "18446744073709551616" ) ), "6627890308811632801" ) );
+	assert ( equal ( powmod ( CBigInt ( 123456789 ), CBigInt ( 65537 ), CBigInt ( "170141183460469231731687303715884105727" ) ),
+	                 "142853123101158166119999597599049700840" ) );
+	assert ( equal ( powmod ( CBigInt ( 5 ), CBigInt ( 0 ), CBigInt ( 1 ) ), "0" ) );
+
+	a = "12345678901234567890";
+	b = "-98765432109876543210";
+	CBigInt c ( "11111111111111111111" ), d ( "22222222222222222222" ), e ( 7 );
+	c = b * c + d * a + e;
+	assert ( equal ( c, "-823045270082304526991769547299176954723" ) );
+	assert ( c == b * "11111111111111111111" + d * a + 7 );
+	c = a;
+	c = c * c + c;
+	assert ( equal ( c, "152415787532388367514250878776253619990" ) );
+	e = a * -1;
+	assert ( equal ( a * b + e * b + d, "22222222222222222222" ) );
+	assert ( equal ( a * b + e * b, "0" ) );
+
+	const char digits[] = "-000123456789012345678901234567890xyz";
+	auto [digits_end, error] = from_chars ( digits, digits + sizeof ( digits ) - 1, a );
+	assert ( error == std::errc () && digits_end == digits + 34 );
+	assert ( equal ( a, "-123456789012345678901234567890" ) );
+	assert ( from_chars ( digits + 34, digits + 37, a ) . ec == std::errc::invalid_argument );
+	assert ( equal ( a, "-123456789012345678901234567890" ) );
+	a = std::string ( "  -0000" );
+	assert ( equal ( a, "0" ) );
+	try {
+		a = "12 34";
+		assert ( "missing an exception" == nullptr );
+	} catch ( const std::invalid_argument & e ) {
+		assert ( equal ( a, "0" ) );
+	}
+	a = INT64_MIN;
+	assert ( equal ( a, "-9223372036854775808" ) );
+	CBigInt from_bool ( false );
+	assert ( equal ( from_bool, "0" ) && from_bool == false );
+	from_bool = true;
+	assert ( equal ( from_bool, "1" ) && from_bool == true && equal ( from_bool + true, "2" ) && equal ( from_bool * false, "0" ) );
+	assert ( CFixedBigInt<128> ( true ) == 1 && CFixedBigInt<128> ( false ) == 0 );
+
+	std::string huge_digits ( "9" );
+	for ( size_t i = 1; i < 12000; ++i )
+		huge_digits += char ( '0' + ( i * 7 + i / 13 ) % 10 );
+	CBigInt huge_x ( huge_digits ), huge_y ( huge_digits . substr ( 0, 11000 ) ), short_y ( "-" + huge_digits . substr ( 0, 2500 ) );
+	CBigInt sequential = huge_x * huge_y, sequential_short = huge_x * short_y;
+	CBigInt::setMultiplyThreads ( 4 );
+	assert ( huge_x * huge_y == sequential && huge_x * short_y == sequential_short );
+	CBigInt::setMultiplyThreads ( 3, 64 );
+	assert ( huge_x * huge_y == sequential && huge_x * short_y == sequential_short );
+	assert ( sequential / huge_y == huge_x && sequential_short / huge_x == short_y );
+	CBigInt::setMultiplyThreads ( 1 );
+
+	std::vector<CBigInt> chains, kernel_results[2];
+	CBigInt power ( 1 ), low_lanes;
+	for ( size_t limbs = 1; limbs <= 33; ++limbs ) {
+		power *= 4294967296LL;
+		if ( limbs == 8 )
+			low_lanes = power * -1;
+		if ( limbs >= 16 )
+			for ( const CBigInt & x : { power, power + -1, power + low_lanes, power + low_lanes / 2 + 1 } ) {
+				chains . push_back ( x );
+				chains . push_back ( x * -1 );
+			}
+	}
+	for ( bool is_simd : { false, true } ) {
+		CBigInt::setSimdKernels ( is_simd );
+		for ( const CBigInt & x : chains )
+			for ( const CBigInt & y : chains ) {
+				CBigInt z = x;
+				z += y;
+				kernel_results[is_simd] . push_back ( z );
+				kernel_results[is_simd] . push_back ( x * y );
+				kernel_results[is_simd] . push_back ( CBigInt ( ( x < y ) - ( y < x ) ) );
+			}
+	}
+	assert ( kernel_results[0] == kernel_results[1] );
+	assert ( power + -1 + 1 == power && power + -1 + power * -1 == -1 && power + low_lanes + low_lanes * -1 == power );
+
+	static_assert ( CFixedBigInt<256> ( 3 ) * CFixedBigInt<256> ( -5 ) + CFixedBigInt<256> ( 16 ) == 1 );
+	static_assert ( CFixedBigInt<64> ( UINT64_MAX ) + CFixedBigInt<64> ( 1 ) == 0 );
+	static_assert ( CFixedBigInt<512> ( -1 ) < CFixedBigInt<512> ( 0u ) );
+	CFixedBigInt<256> f ( "123456789012345678901234567890123456789012345678901234567890" ), g ( "-98765432109876543210987654321" );
+	assert ( equal ( CBigInt ( f * g ), "52368061357436100098322515159540755403535914292897322986696549432486611496142" ) );
+	assert ( equal ( CBigInt ( f * f * f ), "46753884944548488280862419560801002326031074918522297152127862348122837043144" ) );
+	assert ( equal ( CBigInt ( f + g ), "123456789012345678901234567890024691356902469135690246913569" ) );
+	assert ( CBigInt ( f ) * CBigInt ( g ) < CBigInt ( f * g ) && g < 0 && g < f );
+	assert ( CFixedBigInt<256> ( -7 ) / CFixedBigInt<256> ( 2 ) == -3 && CFixedBigInt<256> ( -7 ) % CFixedBigInt<256> ( 2 ) == -1 );
+	g = CFixedBigInt<256> ( "57896044618658097711785492504343953926634992332820282019728792003956564819967" );
+	g += CFixedBigInt<256> ( 1 );
+	assert ( equal ( CBigInt ( g ), "-57896044618658097711785492504343953926634992332820282019728792003956564819968" ) );
+	assert ( a + CFixedBigInt<256> ( 8 ) == "-9223372036854775800" );
+	std::ostringstream oss;
+	oss << std::hex << CFixedBigInt<128> ( -255 );
+	assert ( oss . str () == "-ff" );
+	static_assert ( CFixedBigInt<256> ( 3 ) * -5 + 16 == 1 && 16 + -5 * CFixedBigInt<256> ( 3 ) == 1 );
+	static_assert ( CFixedBigInt<64> ( UINT64_MAX ) + 1u == 0 && 2 * CFixedBigInt<64> ( INT64_MIN ) == 0 );
+	f += 1;
+	f *= -2;
+	assert ( equal ( CBigInt ( f ), "-246913578024691357802469135780246913578024691357802469135782" ) );
+	assert ( f + 5 == 5 + f && f * 3ull == 3ull * f && f * 3ull == f + f + f );
+	g += INT64_MAX;
+	g *= static_cast<unsigned char> ( 2 );
+	assert ( g == INT64_MAX * CFixedBigInt<256> ( 2 ) );
+
+	std::vector<CBigInt> batch_x { CBigInt ( "18446744073709551615" ), CBigInt ( -5 ), CBigInt ( 0 ), CBigInt ( "-340282366920938463463374607431768211456" ) };
+	std::vector<CBigInt> batch_y { CBigInt ( 1 ), CBigInt ( 5 ), CBigInt ( -3 ), CBigInt ( "340282366920938463463374607431768211455" ) };
+	std::vector<CBigInt> batch_result ( 4 );
+	CBigInt::addMany ( batch_x, batch_y, batch_result );
+	assert ( equal ( batch_result[0], "18446744073709551616" ) && equal ( batch_result[1], "0" ) );
+	assert ( equal ( batch_result[2], "-3" ) && equal ( batch_result[3], "-1" ) );
+	CBigInt::addMany ( batch_x, batch_x, batch_x );
+	assert ( equal ( batch_x[0], "36893488147419103230" ) && equal ( batch_x[1], "-10" ) );
+	assert ( equal ( CBigInt::sum ( batch_y ), "340282366920938463463374607431768211458" ) );
+	assert ( equal ( CBigInt::sum ( batch_result ), "18446744073709551612" ) );
+	assert ( equal ( CBigInt::sum ( {} ), "0" ) );
+	assert ( equal ( CBigInt::dot ( batch_x, batch_y ), "-231584178474632390847141970017375815705859404597439251151951525312815303753780" ) );
+	try {
+		CBigInt::addMany ( batch_x, batch_y, std::span<CBigInt> ( batch_result ) . first ( 3 ) );
+		assert ( "missing an exception" == nullptr );
+	} catch ( const std::invalid_argument & e ) {
+	}
+
+	std::vector<CBigInt> many_x ( 5000 ), many_y ( 5000 ), many_result ( 5000 );
+	CBigInt expected_sum, expected_dot;
+	for ( size_t i = 0; i < many_x . size (); ++i ) {
+		many_x[i] = CBigInt ( huge_digits . substr ( 0, 1 + i % 60 ) ) * ( i % 3 ? 1 : -1 );
+		many_y[i] = static_cast<int64_t> ( i * 0x9E3779B97F4A7C15ULL );
+		expected_sum += many_x[i];
+		expected_dot += many_x[i] * many_y[i];
+	}
+	assert ( CBigInt::sum ( many_x, 4 ) == expected_sum && CBigInt::sum ( many_x, 4 ) == CBigInt::sum ( many_x ) );
+	assert ( CBigInt::dot ( many_x, many_y, 3 ) == expected_dot && CBigInt::dot ( many_y, many_x, 4 ) == expected_dot );
+	CBigInt::addMany ( many_x, many_y, many_result, 4 );
+	std::vector<CBigInt> many_twice ( many_result );
+	CBigInt::addMany ( many_twice, many_x, many_twice, 3 );
+	CBigInt::addMany ( many_x, many_x, many_x, 4 );
+	for ( size_t i = 0; i < many_x . size (); ++i )
+		assert ( many_result[i] + many_result[i] == many_x[i] + many_y[i] + many_y[i] && many_twice[i] == many_x[i] + many_y[i] );
+
+#ifdef BENCHMARK
+	benchmarkPowmod();
+	benchmarkConversion();
+	benchmarkAllocations();
+	benchmarkPolynomial();
+	benchmarkParallelMultiply();
+	benchmarkLimbKernels();
+	benchmarkParse();
+	benchmarkFixedWidth<256>();
+	benchmarkFixedWidth<512>();
+	benchmarkFixedWidth<1024>();
+	benchmarkBatch();
+#endif /* BENCHMARK */
+
 	return EXIT_SUCCESS;
 }
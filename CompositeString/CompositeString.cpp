@@ -6,57 +6,180 @@
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <memory>
 #include <stdexcept>
 #include <utility>
+#include <chrono>
 #endif /* __PROGTEST__ */
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <array>
+#include <vector>
+#include <span>
+#include <iterator>
+#include <unordered_map>
+#include <mutex>
+#include <random>
+
 // ---------------------------------------------------------------------------------------------------------------------
 
 class CSource {
 public:
-	explicit CSource(std::shared_ptr<char[]> data)
-			: next_(nullptr), data_(std::move(data)) {}
+	explicit CSource(const char* str, size_t length, size_t hash)
+			: length_(length), hash_(hash), data_(new char[length + 1]) {
+		std::memcpy(data_.get(), str, length);
+		data_[length] = '\0';
+	}
+
+	CSource(const CSource& src) = delete;
 
-	~CSource() = default;
+	~CSource();
 
 	// -----------------------------------------------------------------------------------------------------------------
 
-	[[nodiscard]] CSource* getNext() const {
-		return next_;
+	CSource& operator=(const CSource& src) = delete;
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	[[nodiscard]] size_t getLength() const {
+		return length_;
 	}
 
-	[[nodiscard]] std::shared_ptr<char[]> getData() const {
-		return data_;
+	[[nodiscard]] size_t getHash() const {
+		return hash_;
 	}
 
 	[[nodiscard]] const char* getRawData() const {
 		return data_.get();
 	}
 
+	[[nodiscard]] std::string_view getView() const {
+		return {data_.get(), length_};
+	}
+
+private:
+	size_t length_, hash_;
+	std::unique_ptr<char[]> data_;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+/*
+ * CSourcePool deduplicates source strings by content. Sources are indexed by their hash in shards with their own
+ * locks, so concurrent lookups of different strings rarely contend. The pool only keeps weak references, a source
+ * unregisters itself once the last patch referencing it dies.
+ */
+class CSourcePool {
+public:
+	static CSourcePool& instance() {
+		static CSourcePool pool;
+
+		return pool;
+	}
+
 	// -----------------------------------------------------------------------------------------------------------------
 
-	CSource& setNext(CSource* next) {
-		next_ = next;
+	[[nodiscard]] std::shared_ptr<const char[]> acquire(const char* str, size_t length) {
+		CKey key {std::string_view(str, length), std::hash<std::string_view> {}(std::string_view(str, length))};
+		std::shared_ptr<CSource> source;
+		CShard& shard = shardOf_(key.hash);
+		std::lock_guard<std::mutex> lock(shard.mutex);
 
-		return *this;
+		auto source_it = shard.sources.find(key);
+		if (source_it != shard.sources.end())
+			source = source_it->second.lock();
+
+		if (!source) {
+			// an expired entry belongs to a source being destroyed, its key must not outlive its data
+			if (source_it != shard.sources.end())
+				shard.sources.erase(source_it);
+
+			source = std::make_shared<CSource>(str, length, key.hash);
+			shard.sources.emplace(CKey {source->getView(), key.hash}, source);
+		}
+
+		return {source, source->getRawData()};
+	}
+
+	void release(const CSource& source) {
+		CShard& shard = shardOf_(source.getHash());
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		// the entry may already belong to a new source with the same content
+		auto source_it = shard.sources.find(CKey {source.getView(), source.getHash()});
+		if (source_it != shard.sources.end() && source_it->second.expired())
+			shard.sources.erase(source_it);
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	[[nodiscard]] size_t size() {
+		size_t source_count = 0;
+
+		for (CShard& shard : shards_) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			source_count += shard.sources.size();
+		}
+
+		return source_count;
 	}
 
 private:
-	CSource* next_;
-	std::shared_ptr<char[]> data_;
+	struct CKey {
+		std::string_view view;
+		size_t hash;
+
+		bool operator==(const CKey& other) const {
+			return view == other.view;
+		}
+	};
+
+	struct CKeyHash {
+		size_t operator()(const CKey& key) const {
+			return key.hash;
+		}
+	};
+
+	struct CShard {
+		std::mutex mutex;
+		std::unordered_map<CKey, std::weak_ptr<CSource>, CKeyHash> sources;
+	};
+
+	static constexpr const size_t SHARD_COUNT_ = 16;
+
+	std::array<CShard, SHARD_COUNT_> shards_;
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	CSourcePool() = default;
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	CShard& shardOf_(size_t hash) {
+		return shards_[hash % SHARD_COUNT_];
+	}
 };
 
+// ---------------------------------------------------------------------------------------------------------------------
+
+inline CSource::~CSource() {
+	CSourcePool::instance().release(*this);
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
 class CPatch {
 public:
 	CPatch()
-			: offset_(0), length_(0), end_index_(0), data_(nullptr) {}
+			: offset_(0), length_(0), data_(nullptr) {}
 
-	explicit CPatch(size_t offset, size_t length, size_t end_index, std::shared_ptr<char[]> data)
-			: offset_(offset), length_(length), end_index_(end_index), data_(std::move(data)) {}
+	explicit CPatch(size_t offset, size_t length, std::shared_ptr<const char[]> data)
+			: offset_(offset), length_(length), data_(std::move(data)) {}
 
 	~CPatch() = default;
 
@@ -70,11 +193,7 @@ public:
 		return length_;
 	}
 
-	[[nodiscard]] size_t getEndIndex() const {
-		return end_index_;
-	}
-
-	[[nodiscard]] std::shared_ptr<char[]> getData() const {
+	[[nodiscard]] std::shared_ptr<const char[]> getData() const {
 		return data_;
 	}
 
@@ -96,14 +215,18 @@ public:
 		return *this;
 	}
 
-	CPatch& setEndIndex(size_t end_index) {
-		end_index_ = end_index;
+	// -----------------------------------------------------------------------------------------------------------------
 
-		return *this;
+	[[nodiscard]] std::string_view getView() const {
+		return {data_.get() + offset_, length_};
 	}
 
 	// -----------------------------------------------------------------------------------------------------------------
 
+	[[nodiscard]] CPatch slice(size_t from, size_t length) const {
+		return CPatch(offset_ + from, length, data_);
+	}
+
 	[[nodiscard]] char* toStr() const {
 		char* str = new char[length_ + 1];
 		std::memcpy(str, data_.get() + offset_, length_);
@@ -113,428 +236,579 @@ public:
 	}
 
 private:
-	size_t offset_, length_, end_index_;
-	std::shared_ptr<char[]> data_;
+	size_t offset_, length_;
+	std::shared_ptr<const char[]> data_;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
-//class CPatchStr {
-//public:
-//	// ✅
-//	CPatchStr()
-//			: patches_(nullptr), patch_count_(0), patch_capacity_(0) {}
-//
-//	// ✅
-//	CPatchStr(const char* str)
-//			: patches_(nullptr), patch_count_(0), patch_capacity_(0) {
-//		if (str && *str != '\0') {
-//			auto new_data = createData_(str);
-//			auto new_source = new CSource(new_data);
-//			auto new_patch = CPatch(0, std::strlen(str), std::strlen(str), new_data);
-//
-//			appendSource_(new_source);
-//			appendPatch_(&new_patch);
-//		}
-//	}
-//
-//	// ✅
-//	CPatchStr(const CPatchStr& src)
-//			: patches_(nullptr), patch_count_(0), patch_capacity_(0) {
-//		if (this != &src)
-//			copyPatches_(src.patches_, src.patch_count_, src.patch_capacity_);
-//	}
-//
-//	// ✅
-//	~CPatchStr() {
-//		deletePatches_();
-//		deleteSources_();
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	// ✅
-//    CPatchStr& operator=(const CPatchStr& src) {
-//	    if (this != &src)
-//		    copyPatches_(src.patches_, src.patch_count_, src.patch_capacity_);
-//
-//	    return *this;
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	// ✅
-//	CPatchStr subStr(size_t from, size_t len) const {
-//		size_t to = from + len, str_length = (patch_count_ ? patches_[patch_count_ - 1].getEndIndex() : 0);
-//
-//		if (from >= str_length || to > str_length)
-//			throw std::out_of_range("subStr: index out of range!");
-//
-//		CPatchStr substr;
-//
-//		if (from == to)
-//			return substr;
-//
-//		int patch_start_index = findPatchIndex_(from), patch_end_index = findPatchIndex_(to - 1);
-//
-////		std::cout << "SUBSTR START" << std::endl;
-////		for (size_t i = 0; i < patch_count_; ++i)
-////			std::cout << "PATCH N" << i << ": Offset=" << patches_[i].getOffset() << ", Length=" << patches_[i].getLength() << ", TEXT=" << patches_[i].getRawData() << std::endl;
-////		std::cout << "---------------------------" << std::endl;
-//
-//		for (size_t patch_index = patch_start_index, str_end_index = 0; patch_index <= static_cast<size_t>(patch_end_index); ++patch_index) {
-//			const auto& src_patch = patches_[patch_index];
-//			size_t new_patch_offset = src_patch.getOffset(), new_patch_length = src_patch.getLength();
-//
-//			if (patch_start_index == patch_end_index) {
-//				new_patch_offset = src_patch.getOffset() + (from - (src_patch.getEndIndex() - src_patch.getLength()));
-//				new_patch_length = len; // to - (src_patch.getEndIndex() - src_patch.getLength()) - new_patch_offset;
-//			} else if (patch_index == static_cast<size_t>(patch_start_index)) {
-//				new_patch_offset = src_patch.getOffset() + (from - (src_patch.getEndIndex() - src_patch.getLength()));
-//				new_patch_length = src_patch.getEndIndex() - from;
-//			} else if (patch_index == static_cast<size_t>(patch_end_index)) {
-//				new_patch_offset = src_patch.getOffset();
-//				new_patch_length = src_patch.getLength() - (src_patch.getEndIndex() - to);
-//			}
-//
-//			auto new_patch = CPatch(new_patch_offset, new_patch_length,
-//										str_end_index += new_patch_length, src_patch.getData());
-//
-//			substr.appendPatch_(&new_patch);
-//		}
-//
-////		std::cout << "SUBSTR END" << std::endl;
-////		for (size_t i = 0; i < substr.patch_count_; ++i)
-////			std::cout << "PATCH N" << i << ": Offset=" << substr.patches_[i].getOffset() << ", Length=" << substr.patches_[i].getLength() << ", TEXT=" << substr.patches_[i].getRawData() << std::endl;
-////		std::cout << "---------------------------" << std::endl;
-//
-//		return substr;
-//	}
-//
-//	// ✅
-//	char* toStr() const {
-//		size_t str_length = (patch_count_ ? patches_[patch_count_ - 1].getEndIndex() : 0);
-//		char* str = new char[str_length + 1];
-//		str[str_length] = '\0';
-//
-////		std::cout << "--------------JKL-------------" << std::endl;
-////		for (size_t i = 0; i < patch_count_; ++i)
-////			std::cout << "PATCH N" << i << ": Offset=" << patches_[i].getOffset() << ", Length=" << patches_[i].getLength() << ", TEXT=" << patches_[i].getRawData() << std::endl;
-//
-//		for (size_t patch_index = 0, str_index = 0; patch_index < patch_count_;
-//				str_index += patches_[patch_index].getLength(), ++patch_index) {
-//			const auto& src_patch = patches_[patch_index];
-//
-//			std::memcpy(str + str_index, src_patch.getRawData() + src_patch.getOffset(),
-//						src_patch.getLength());
-//		}
-//
-//		return str;
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	// ✅
-//    CPatchStr& append(const CPatchStr& src) {
-//		size_t resized_patch_capacity = DEFAULT_CAPACITY_;
-//
-//		while (patch_count_ + src.patch_count_ > resized_patch_capacity)
-//			resized_patch_capacity *= RESIZE_FACTOR_;
-//
-//		auto resized_patches = new CPatch[resized_patch_capacity];
-//		size_t patch_index = 0;
-//
-//		for (; patch_index < patch_count_; ++patch_index)
-//			resized_patches[patch_index] = CPatch(patches_[patch_index].getOffset(), patches_[patch_index].getLength(),
-//			                                      patches_[patch_index].getEndIndex(), patches_[patch_index].getData());
-//
-//		for (size_t i = 0, str_end_index = (patch_index ? resized_patches[patch_index - 1].getEndIndex() : 0);
-//				i < src.patch_count_; ++i, ++patch_index)
-//			resized_patches[patch_index] = CPatch(src.patches_[i].getOffset(), src.patches_[i].getLength(),
-//			                                      str_end_index += src.patches_[i].getLength(), src.patches_[i].getData());
-//
-//		deletePatches_();
-//
-//		patch_capacity_ = resized_patch_capacity;
-//		patch_count_ = patch_index;
-//		patches_ = resized_patches;
-//
-//	    return *this;
-//	}
-//
-//    CPatchStr& insert(size_t pos, const CPatchStr& src) {
-//	    size_t str_length = (patch_count_ ? patches_[patch_count_ - 1].getEndIndex() : 0);
-//
-//		if (pos > str_length)
-//		    throw std::out_of_range("insert: index out of range!");
-//		else if (pos == str_length) {
-//		    append(src);
-//			return *this;
-//		}
-//
-////	    for (size_t i = 0; i < patch_count_; ++i)
-////		    std::cout << "PATCH N" << i << ": Offset=" << patches_[i].getOffset() << ", Length=" << patches_[i].getLength() << ", TEXT=" << patches_[i].getRawData() << std::endl;
-////	    std::cout << "---------------------------" << std::endl;
-////	    std::cout << "Src" << std::endl;
-////	    for (size_t i = 0; i < src.patch_count_; ++i)
-////		    std::cout << "PATCH N" << i << ": Offset=" << src.patches_[i].getOffset() << ", Length=" << src.patches_[i].getLength() << ", TEXT=" << src.patches_[i].getRawData() << std::endl;
-////	    std::cout << "---------------------------" << std::endl;
-//
-//	    int patch_insert_index = findPatchIndex_(pos);
-//	    size_t new_patch_capacity = DEFAULT_CAPACITY_, new_patch_index = 0;
-//
-//	    while (patch_count_ + src.patch_count_ + 1 > new_patch_capacity)
-//		    new_patch_capacity *= RESIZE_FACTOR_;
-//
-//	    auto new_patches = new CPatch[new_patch_capacity];
-//
-//	    for (size_t i = 0; i < static_cast<size_t>(patch_insert_index); ++i)
-//		    new_patches[new_patch_index++] = patches_[i];
-//
-//	    if (pos != (patches_[patch_insert_index].getEndIndex() - patches_[patch_insert_index].getLength())) {
-//		    const auto& divided_patch = patches_[patch_insert_index];
-//		    size_t new_patch_length = pos - (divided_patch.getEndIndex() - divided_patch.getLength());
-//
-//		    if (new_patch_length > 0)
-//			    new_patches[new_patch_index++] = CPatch(divided_patch.getOffset(), new_patch_length,
-//														pos, divided_patch.getData());
-//	    }
-//
-//	    size_t str_end_index = pos;
-//	    for (size_t i = 0; i < src.patch_count_; ++i) {
-//		    const CPatch& src_patch = src.patches_[i];
-//
-//		    new_patches[new_patch_index++] = CPatch(src_patch.getOffset(), src_patch.getLength(),
-//													str_end_index += src_patch.getLength(), src_patch.getData());
-//	    }
-//
-//		if (pos != (patches_[patch_insert_index].getEndIndex() - patches_[patch_insert_index].getLength())) {
-//		    const auto& divided_patch = patches_[patch_insert_index];
-//		    size_t new_patch_offset = divided_patch.getOffset() + (pos - (divided_patch.getEndIndex() - divided_patch.getLength()));
-//		    size_t new_patch_length = divided_patch.getEndIndex() - pos;
-//
-//		    new_patches[new_patch_index++] = CPatch(new_patch_offset, new_patch_length,
-//													str_end_index += new_patch_length, divided_patch.getData());
-//	    }
-//
-//	    for (size_t i = ((patches_[patch_insert_index].getEndIndex() - patches_[patch_insert_index].getLength()) - pos == 0 ? patch_insert_index : patch_insert_index + 1);
-//				i < patch_count_; ++i)
-//		    new_patches[new_patch_index++] = CPatch(patches_[i].getOffset(), patches_[i].getLength(),
-//		                                            str_end_index += patches_[i].getLength(), patches_[i].getData());
-//
-//	    deletePatches_();
-//
-//	    patches_ = new_patches;
-//	    patch_count_ = new_patch_index;
-//		patch_capacity_ = new_patch_capacity;
-//
-////	    std::cout << "READY!" << std::endl;
-////	    for (size_t i = 0; i < patch_count_; ++i)
-////		    std::cout << "PATCH N" << i << ": Offset=" << patches_[i].getOffset() << ", Length=" << patches_[i].getLength() << ", TEXT=" << patches_[i].getRawData() << std::endl;
-//
-//		return *this;
-//	}
-//
-//    CPatchStr& remove(size_t from, size_t len) {
-//	    size_t to = from + len, str_length = (patch_count_ ? patches_[patch_count_ - 1].getEndIndex() : 0);
-//
-//	    if (from >= str_length || to > str_length)
-//		    throw std::out_of_range("remove: index out of range!");
-//
-//	    if (len == 0)
-//		    return *this;
-//
-////	    std::cout << "From: " << from << " To: " << to << std::endl;
-//
-//	    int patch_start_index = findPatchIndex_(from), patch_end_index = findPatchIndex_(to - 1);
-//
-////	    std::cout << "START: " << patch_start_index << " END: " << patch_end_index << std::endl;
-//
-//	    size_t new_patch_capacity = patch_count_ - (patch_end_index - patch_start_index + 1) + 2, new_patch_index = 0;
-//	    auto new_patches = new CPatch[new_patch_capacity];
-//
-//	    for (size_t i = 0; i < static_cast<size_t>(patch_start_index); ++i)
-//		    new_patches[new_patch_index++] = patches_[i];
-//
-//	    if (from > (patches_[patch_start_index].getEndIndex() - patches_[patch_start_index].getLength())) {
-//		    const CPatch& divided_patch = patches_[patch_start_index];
-//		    size_t new_patch_length = from - (divided_patch.getEndIndex() - divided_patch.getLength());
-//
-//		    new_patches[new_patch_index++] = CPatch(divided_patch.getOffset(), new_patch_length, from, divided_patch.getData());
-//	    }
-//
-//	    if ((to - 1) >= (patches_[patch_end_index].getEndIndex() - patches_[patch_end_index].getLength()) && (to - 1) < patches_[patch_end_index].getEndIndex()) {
-//		    const CPatch& divided_patch = patches_[patch_end_index];
-//		    size_t new_patch_offset = divided_patch.getOffset() + (to - (divided_patch.getEndIndex() - divided_patch.getLength())),
-//			       new_patch_length = divided_patch.getEndIndex() - to;
-//
-//		    new_patches[new_patch_index++] = CPatch(new_patch_offset, new_patch_length,
-//													from + new_patch_length, divided_patch.getData());
-//	    }
-//
-//	    for (size_t i = patch_end_index + 1; i < patch_count_; ++i)
-//		    new_patches[new_patch_index++] = CPatch(patches_[i].getOffset(), patches_[i].getLength(),
-//													patches_[i].getEndIndex() - len, patches_[i].getData());
-//
-//	    delete[] patches_;
-//	    patches_ = new_patches;
-//	    patch_count_ = new_patch_index;
-//		patch_capacity_ = new_patch_capacity;
-//
-//	    return *this;
-//	}
-//
-//	size_t patch_count_, patch_capacity_;
-//
-//private:
-//	static inline CSource* sources_ = nullptr;
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	CPatch* patches_;
-////	size_t patch_count_, patch_capacity_;
-//	static constexpr const size_t DEFAULT_CAPACITY_ = 100, RESIZE_FACTOR_ = 2;
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	static std::shared_ptr<char[]> createData_(const char* str) {
-//		std::shared_ptr<char[]> data(new char[std::strlen(str) + 1], std::default_delete<char[]>());
-//		std::strcpy(data.get(), str);
-//
-//		return data;
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	[[nodiscard]] int findPatchIndex_(size_t str_index) const { // бдить
-//		size_t lower_index = 0, upper_index = patch_count_ - 1;
-//		int target_index = -1;
-//
-////		std::cout << "FIND: " << "Lo=" << lower_index << " Hi=" << upper_index << " StrIDX=" << str_index << std::endl;
-////	    for (size_t i = 0; i < patch_count_; ++i)
-////		    std::cout << "PATCH N" << i << ": Offset=" << patches_[i].getOffset() << ", Length=" << patches_[i].getLength() << ", EI=" << patches_[i].getEndIndex() << ", TEXT=" << patches_[i].getRawData() << std::endl;
-////		std::cout << std::endl;
-//
-//		while (lower_index <= upper_index) {
-//			size_t mid_index = lower_index + (upper_index - lower_index) / 2;
-//			const CPatch& patch = patches_[mid_index];
-//
-////			std::cout << "HM: " << "Lo=" << lower_index << " Hi=" << upper_index << " Mid=" << mid_index << std::endl;
-//
-//			if (str_index < (patch.getEndIndex() - patch.getLength()))
-//				upper_index = mid_index - 1;
-//			else if (str_index >= patch.getEndIndex())
-//				lower_index = mid_index + 1;
-//			else {
-//				target_index = static_cast<int>(mid_index);
-//				break;
-//			}
-//		}
-//
-//		return target_index;
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	// ✅
-//	void copyPatches_(const CPatch* src_patches, size_t src_patch_count, size_t src_patch_capacity) {
-//		deletePatches_();
-//
-//		patch_capacity_ = src_patch_capacity;
-//		patches_ = new CPatch[patch_capacity_];
-//
-//		appendPatches_(src_patches, src_patch_count);
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	// ✅
-//	static void appendSource_(CSource* src_source) {
-//		if (!sources_)
-//			sources_ = src_source;
-//		else
-//			for (auto current_source = sources_; current_source; current_source = current_source->getNext()) {
-//				if (strcmp(current_source->getRawData(), src_source->getRawData()) == 0)
-//					break;
-//
-//				if (!current_source->getNext()) {
-//					current_source->setNext(src_source);
-//					break;
-//				}
-//			}
-//	}
-//
-//	// ✅
-//	void appendPatch_(CPatch* src_patch) {
-//		resizePatches_(patch_count_ + 1);
-//
-//		patches_[patch_count_++] = *src_patch;
-//	}
-//
-//	// ✅
-//	void appendPatches_(const CPatch* src_patches, size_t src_patch_count) {
-//		for (size_t patch_index = 0, str_end_index = (patch_count_ ? patches_[patch_count_ - 1].getEndIndex() : 0);
-//				patch_index < src_patch_count; ++patch_index) {
-//			const auto& src_patch = src_patches[patch_index];
-//			auto new_patch = CPatch(src_patch.getOffset(), src_patch.getLength(),
-//										str_end_index += src_patch.getLength(), src_patch.getData());
-//
-//			appendPatch_(&new_patch);
-//		}
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	// ✅
-//	void resizePatches_(size_t new_patch_count) {
-//		if (!patches_) {
-//			patch_capacity_ = DEFAULT_CAPACITY_;
-//			patches_ = new CPatch[patch_capacity_];
-//		} else {
-//			size_t resized_patch_capacity = patch_capacity_;
-//
-//			while (patch_count_ + new_patch_count > resized_patch_capacity)
-//				resized_patch_capacity *= RESIZE_FACTOR_;
-//
-//			if (resized_patch_capacity > patch_capacity_) {
-//				auto resized_patches = new CPatch[resized_patch_capacity];
-//
-//				size_t patch_index = 0;
-//
-//				for (; patch_index < patch_count_; ++patch_index)
-//					resized_patches[patch_index] = CPatch(patches_[patch_index].getOffset(), patches_[patch_index].getLength(),
-//					                                      patches_[patch_index].getEndIndex(), patches_[patch_index].getData());
-//
-//				deletePatches_();
-//
-//				patch_capacity_ = resized_patch_capacity;
-//				patch_count_ = patch_index;
-//				patches_ = resized_patches;
-//			}
-//		}
-//	}
-//
-//	// -----------------------------------------------------------------------------------------------------------------
-//
-//	// ✅
-//	static void deleteSources_() {
-//		for (auto current_source = sources_; current_source; ) {
-//			auto next_source = current_source->getNext();
-//			delete current_source;
-//			current_source = next_source;
-//		}
-//
-//		sources_ = nullptr;
-//	}
-//
-//	// ✅
-//	void deletePatches_() {
-//		patch_count_ = patch_capacity_ = 0;
-//		delete[] patches_;
-//		patches_ = nullptr;
-//	}
-//};
+/*
+ * CPatchStr is a rope: a randomized binary search tree of patches keyed by their position in the string, every node
+ * knows the length and the patch count of its subtree. Nodes are shared between copies and copied on write, so copying
+ * is O(1) and insert, remove, subStr and append are O(log n) in the number of patches.
+ */
+class CPatchStr {
+	struct CNode;
+	using CNodePtr = std::shared_ptr<CNode>;
+
+public:
+	// Forward iterator over the patches as string views into their sources, nothing is copied.
+	class CSegmentIterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = std::string_view;
+
+		CSegmentIterator() = default;
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		std::string_view operator*() const {
+			return path_.back()->patch.getView();
+		}
+
+		CSegmentIterator& operator++() {
+			const CNode* node = path_.back()->right.get();
+			path_.pop_back();
+			pushLeftSpine_(node);
+			++index_;
+
+			return *this;
+		}
+
+		CSegmentIterator operator++(int) {
+			CSegmentIterator previous = *this;
+			++*this;
+
+			return previous;
+		}
+
+		friend bool operator==(const CSegmentIterator& x, const CSegmentIterator& y) {
+			return x.index_ == y.index_;
+		}
+
+	private:
+		friend class CPatchStr;
+
+		// nodes whose patches are still to be visited, the current one on top
+		std::vector<const CNode*> path_;
+		size_t index_ = 0;
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		CSegmentIterator(const CNode* node, size_t index)
+				: index_(index) {
+			while (node) {
+				size_t left_count = countOf_(node->left);
+
+				if (index < left_count) {
+					path_.push_back(node);
+					node = node->left.get();
+				} else if (index == left_count) {
+					path_.push_back(node);
+					break;
+				} else {
+					index -= left_count + 1;
+					node = node->right.get();
+				}
+			}
+		}
+
+		void pushLeftSpine_(const CNode* node) {
+			for (; node; node = node->left.get())
+				path_.push_back(node);
+		}
+	};
+
+	// The segments of a string, the range keeps them alive even if the string changes meanwhile.
+	class CSegments {
+	public:
+		[[nodiscard]] CSegmentIterator begin() const {
+			return CSegmentIterator(root_.get(), 0);
+		}
+
+		[[nodiscard]] CSegmentIterator end() const {
+			return CSegmentIterator(nullptr, countOf_(root_));
+		}
+
+	private:
+		friend class CPatchStr;
+
+		CNodePtr root_;
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		explicit CSegments(CNodePtr root)
+				: root_(std::move(root)) {}
+	};
+
+	struct CFragmentation {
+		size_t length, patch_count, small_patch_count;
+	};
+
+	static constexpr const size_t npos = static_cast<size_t>(-1);
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	CPatchStr() = default;
+
+	CPatchStr(const char* str) {
+		if (str && *str != '\0') {
+			size_t length = std::strlen(str);
+
+			root_ = makeNode_(CPatch(0, length, CSourcePool::instance().acquire(str, length)));
+		}
+	}
+
+	CPatchStr(const CPatchStr& src) = default;
+
+	~CPatchStr() = default;
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	CPatchStr& operator=(const CPatchStr& src) = default;
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	[[nodiscard]] size_t length() const {
+		return lengthOf_(root_);
+	}
+
+	[[nodiscard]] size_t patchCount() const {
+		return countOf_(root_);
+	}
+
+	[[nodiscard]] CFragmentation fragmentation() const {
+		return {lengthOf_(root_), countOf_(root_), smallOf_(root_)};
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	[[nodiscard]] CPatchStr subStr(size_t from, size_t len) const {
+		checkRange_(from, len, "subStr: index out of range!");
+
+		return CPatchStr(split_(split_(root_, from).second, len).first);
+	}
+
+	char* toStr() const {
+		size_t str_length = length(), str_index = 0;
+		char* str = new char[str_length + 1];
+		str[str_length] = '\0';
+
+		forEachPatch_(root_.get(), [&](const CPatch& patch) {
+			std::memcpy(str + str_index, patch.getRawData() + patch.getOffset(), patch.getLength());
+			str_index += patch.getLength();
+		});
+
+		return str;
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	[[nodiscard]] CSegments segments() const {
+		return CSegments(root_);
+	}
+
+	// Fills segments with up to segments.size() consecutive segments starting at the segment index first,
+	// the views map one to one onto iovec entries for writev.
+	size_t gather(std::span<std::string_view> segments, size_t first = 0) const {
+		size_t segment_count = 0;
+		if (first >= patchCount())
+			return 0;
+
+		for (CSegmentIterator segment_it(root_.get(), first), end_it(nullptr, patchCount());
+				segment_count < segments.size() && segment_it != end_it; ++segment_it)
+			segments[segment_count++] = *segment_it;
+
+		return segment_count;
+	}
+
+	// Writes the patches straight into the stream buffer, patches are mostly too short to pay for a sentry each.
+	std::ostream& writeTo(std::ostream& os) const {
+		std::ostream::sentry sentry(os);
+		if (!sentry)
+			return os;
+
+		bool is_written = true;
+		forEachPatch_(root_.get(), [&](const CPatch& patch) {
+			auto length = static_cast<std::streamsize>(patch.getLength());
+			is_written = is_written && os.rdbuf()->sputn(patch.getRawData() + patch.getOffset(), length) == length;
+		});
+
+		if (!is_written)
+			os.setstate(std::ios::badbit);
+
+		return os;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const CPatchStr& str) {
+		return str.writeTo(os);
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	// Knuth-Morris-Pratt over the segments, the match state carries across patch boundaries. Whenever nothing is
+	// matched, matches inside the current segment are searched for directly and only its tail is fed to the automaton.
+	[[nodiscard]] size_t find(std::string_view needle, size_t from = 0) const {
+		if (from > length())
+			return npos;
+		if (needle.empty())
+			return from;
+
+		std::vector<size_t> failure(needle.size(), 0);
+		for (size_t i = 1, matched = 0; i < needle.size(); ++i) {
+			while (matched > 0 && needle[i] != needle[matched])
+				matched = failure[matched - 1];
+			if (needle[i] == needle[matched])
+				++matched;
+			failure[i] = matched;
+		}
+
+		auto [first_patch, offset] = locate_(from);
+		size_t matched = 0, segment_start = from;
+
+		for (CSegmentIterator segment_it(root_.get(), first_patch), end_it(nullptr, patchCount()); segment_it != end_it;
+				++segment_it, offset = 0) {
+			std::string_view segment = (*segment_it).substr(offset);
+
+			for (size_t i = 0; i < segment.size(); ++i) {
+				if (matched == 0 && segment.size() - i >= needle.size()) {
+					if (size_t hit = segment.find(needle, i); hit != std::string_view::npos)
+						return segment_start + hit;
+					i = segment.size() - needle.size() + 1;
+				}
+				if (matched == 0) {
+					auto hit = i < segment.size()
+							   ? static_cast<const char*>(std::memchr(segment.data() + i, needle[0], segment.size() - i))
+							   : nullptr;
+					if (!hit)
+						break;
+					i = static_cast<size_t>(hit - segment.data());
+				}
+
+				while (matched > 0 && segment[i] != needle[matched])
+					matched = failure[matched - 1];
+				if (segment[i] == needle[matched] && ++matched == needle.size())
+					return segment_start + i + 1 - needle.size();
+			}
+
+			segment_start += segment.size();
+		}
+
+		return npos;
+	}
+
+	// Lexicographic comparison of the characters as unsigned chars, like std::strcmp.
+	[[nodiscard]] int compare(const CPatchStr& other) const {
+		if (root_ == other.root_)
+			return 0;
+
+		CSegments x_segments = segments(), y_segments = other.segments();
+		CSegmentIterator x_it = x_segments.begin(), y_it = y_segments.begin(),
+						 x_end = x_segments.end(), y_end = y_segments.end();
+		std::string_view x_segment, y_segment;
+
+		while (true) {
+			if (x_segment.empty() && x_it != x_end) {
+				x_segment = *x_it;
+				++x_it;
+			}
+			if (y_segment.empty() && y_it != y_end) {
+				y_segment = *y_it;
+				++y_it;
+			}
+			if (x_segment.empty() || y_segment.empty())
+				return x_segment.empty() ? (y_segment.empty() ? 0 : -1) : 1;
+
+			size_t chunk = std::min(x_segment.size(), y_segment.size());
+			if (int comparison = std::memcmp(x_segment.data(), y_segment.data(), chunk))
+				return comparison < 0 ? -1 : 1;
+
+			x_segment.remove_prefix(chunk);
+			y_segment.remove_prefix(chunk);
+		}
+	}
+
+	friend bool operator==(const CPatchStr& x, const CPatchStr& y) {
+		return x.length() == y.length() && x.compare(y) == 0;
+	}
+
+	// 64-bit FNV-1a of the characters, equal strings hash equally however they are split into patches.
+	[[nodiscard]] size_t hash() const {
+		uint64_t hash = FNV_OFFSET_BASIS_;
+
+		forEachPatch_(root_.get(), [&](const CPatch& patch) {
+			for (char c : patch.getView())
+				hash = (hash ^ static_cast<unsigned char>(c)) * FNV_PRIME_;
+		});
+
+		return static_cast<size_t>(hash);
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	CPatchStr& append(const CPatchStr& src) {
+		CNodePtr appended = src.root_;
+		root_ = merge_(std::move(root_), std::move(appended));
+		compactIfFragmented_();
+
+		return *this;
+	}
+
+	CPatchStr& insert(size_t pos, const CPatchStr& src) {
+		if (pos > length())
+			throw std::out_of_range("insert: index out of range!");
+		if (!src.root_)
+			return *this;
+
+		CNodePtr inserted = src.root_;
+		auto [left, right] = split_(std::move(root_), pos);
+		root_ = merge_(merge_(std::move(left), std::move(inserted)), std::move(right));
+		compactIfFragmented_();
+
+		return *this;
+	}
+
+	CPatchStr& remove(size_t from, size_t len) {
+		checkRange_(from, len, "remove: index out of range!");
+
+		auto [left, rest] = split_(std::move(root_), from);
+		root_ = merge_(std::move(left), split_(std::move(rest), len).second);
+		compactIfFragmented_();
+
+		return *this;
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	// Copies runs of short patches into fresh sources of up to COMPACT_CHUNK_ characters and joins adjacent slices
+	// of the same source, longer patches keep sharing their sources.
+	CPatchStr& compact() {
+		std::vector<CPatch> patches;
+		std::string run;
+		patches.reserve(patchCount());
+
+		auto flushRun = [&]() {
+			if (!run.empty()) {
+				patches.emplace_back(0, run.size(), CSourcePool::instance().acquire(run.data(), run.size()));
+				run.clear();
+			}
+		};
+
+		forEachPatch_(root_.get(), [&](const CPatch& patch) {
+			if (patch.getLength() < COMPACT_RUN_LENGTH_) {
+				if (run.size() + patch.getLength() > COMPACT_CHUNK_)
+					flushRun();
+				run.append(patch.getView());
+				return;
+			}
+
+			flushRun();
+			if (!patches.empty() && patches.back().getRawData() == patch.getRawData()
+					&& patches.back().getOffset() + patches.back().getLength() == patch.getOffset())
+				patches.back().setLength(patches.back().getLength() + patch.getLength());
+			else
+				patches.push_back(patch);
+		});
+		flushRun();
+
+		root_ = build_(patches, 0, patches.size());
+		compacted_patch_count_ = patches.size();
+
+		return *this;
+	}
+
+	CPatchStr& setAutoCompaction(bool is_enabled) {
+		is_auto_compacting_ = is_enabled;
+
+		return *this;
+	}
+
+private:
+	struct CNode {
+		CPatch patch;
+		CNodePtr left, right;
+		size_t length, count, small_count;
+	};
+
+	// patches shorter than SMALL_PATCH_LENGTH_ count as fragmentation, runs of patches shorter than
+	// COMPACT_RUN_LENGTH_ are copied on compaction, which starts at COMPACT_MIN_PATCHES_ small patches
+	static constexpr const size_t SMALL_PATCH_LENGTH_ = 16, COMPACT_RUN_LENGTH_ = 512, COMPACT_CHUNK_ = 4096,
+								  COMPACT_MIN_PATCHES_ = 1024;
+
+	static constexpr const uint64_t FNV_OFFSET_BASIS_ = 14695981039346656037ULL, FNV_PRIME_ = 1099511628211ULL;
+
+	CNodePtr root_;
+	size_t compacted_patch_count_ = 0;
+	bool is_auto_compacting_ = true;
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	explicit CPatchStr(CNodePtr root)
+			: root_(std::move(root)) {}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	static CNodePtr makeNode_(CPatch patch) {
+		size_t length = patch.getLength();
+
+		return std::make_shared<CNode>(CNode {std::move(patch), nullptr, nullptr, length, 1, length < SMALL_PATCH_LENGTH_});
+	}
+
+	static CNodePtr build_(std::vector<CPatch>& patches, size_t begin, size_t end) {
+		if (begin == end)
+			return nullptr;
+
+		size_t middle = begin + (end - begin) / 2;
+		CNodePtr node = makeNode_(std::move(patches[middle]));
+		node->left = build_(patches, begin, middle);
+		node->right = build_(patches, middle + 1, end);
+
+		return update_(std::move(node));
+	}
+
+	// Nodes referenced only by this string are modified in place, shared ones are copied first.
+	static void own_(CNodePtr& node) {
+		if (node.use_count() != 1)
+			node = std::make_shared<CNode>(*node);
+	}
+
+	static CNodePtr update_(CNodePtr node) {
+		node->length = lengthOf_(node->left) + node->patch.getLength() + lengthOf_(node->right);
+		node->count = countOf_(node->left) + 1 + countOf_(node->right);
+		node->small_count = smallOf_(node->left) + (node->patch.getLength() < SMALL_PATCH_LENGTH_) + smallOf_(node->right);
+
+		return node;
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	static size_t lengthOf_(const CNodePtr& node) {
+		return node ? node->length : 0;
+	}
+
+	static size_t countOf_(const CNodePtr& node) {
+		return node ? node->count : 0;
+	}
+
+	static size_t smallOf_(const CNodePtr& node) {
+		return node ? node->small_count : 0;
+	}
+
+	// Compacts once most patches are small and the patch count has doubled since the last compaction,
+	// so the linear compaction is amortized over the edits that fragmented the string.
+	void compactIfFragmented_() {
+		size_t patch_count = countOf_(root_), small_count = smallOf_(root_);
+
+		if (is_auto_compacting_ && small_count >= COMPACT_MIN_PATCHES_ && small_count * 2 >= patch_count
+				&& patch_count >= 2 * compacted_patch_count_)
+			compact();
+	}
+
+	// Returns the index of the patch containing position pos and the offset of pos within it.
+	[[nodiscard]] std::pair<size_t, size_t> locate_(size_t pos) const {
+		size_t patch_index = 0;
+
+		for (const CNode* node = root_.get(); node; ) {
+			size_t left_length = lengthOf_(node->left), patch_length = node->patch.getLength();
+
+			if (pos < left_length)
+				node = node->left.get();
+			else if (pos < left_length + patch_length)
+				return {patch_index + countOf_(node->left), pos - left_length};
+			else {
+				pos -= left_length + patch_length;
+				patch_index += countOf_(node->left) + 1;
+				node = node->right.get();
+			}
+		}
+
+		return {patch_index, 0};
+	}
+
+	void checkRange_(size_t from, size_t len, const char* message) const {
+		size_t str_length = length();
+
+		if (from > str_length || len > str_length - from)
+			throw std::out_of_range(message);
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	// Splits the string before position pos, a patch spanning pos is cut into two patches sharing its data.
+	static std::pair<CNodePtr, CNodePtr> split_(CNodePtr node, size_t pos) {
+		if (!node || pos == 0)
+			return {nullptr, std::move(node)};
+		if (pos >= node->length)
+			return {std::move(node), nullptr};
+
+		own_(node);
+		size_t patch_start = lengthOf_(node->left), patch_end = patch_start + node->patch.getLength();
+
+		if (pos <= patch_start) {
+			auto [left, right] = split_(std::move(node->left), pos);
+			node->left = std::move(right);
+			return {std::move(left), update_(std::move(node))};
+		}
+		if (pos >= patch_end) {
+			auto [left, right] = split_(std::move(node->right), pos - patch_end);
+			node->right = std::move(left);
+			return {update_(std::move(node)), std::move(right)};
+		}
+
+		size_t cut = pos - patch_start;
+		CNodePtr tail = makeNode_(node->patch.slice(cut, node->patch.getLength() - cut));
+		tail->right = std::move(node->right);
+		node->patch.setLength(cut);
+
+		return {update_(std::move(node)), update_(std::move(tail))};
+	}
+
+	// Concatenates two trees, the root is drawn with probability proportional to the subtree sizes,
+	// which keeps the tree a random binary search tree of expected depth O(log n).
+	static CNodePtr merge_(CNodePtr left, CNodePtr right) {
+		if (!left)
+			return right;
+		if (!right)
+			return left;
+
+		if (random_() % (left->count + right->count) < left->count) {
+			own_(left);
+			left->right = merge_(std::move(left->right), std::move(right));
+			return update_(std::move(left));
+		}
+
+		own_(right);
+		right->left = merge_(std::move(left), std::move(right->left));
+		return update_(std::move(right));
+	}
+
+	static uint64_t random_() {
+		static thread_local std::mt19937_64 generator(std::random_device {}());
+
+		return generator();
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	template<typename F>
+	static void forEachPatch_(const CNode* node, F&& visit) {
+		for (; node; node = node->right.get()) {
+			forEachPatch_(node->left.get(), visit);
+			visit(node->patch);
+		}
+	}
+};
+
+template<>
+struct std::hash<CPatchStr> {
+	size_t operator()(const CPatchStr& str) const {
+		return str.hash();
+	}
+};
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -547,61 +821,261 @@ bool stringMatch(char* str, const char* expected) {
   return res;
 }
 
+#ifdef BENCHMARK
+
+void benchmarkEdits() {
+  constexpr size_t edits = 1000000, report = 250000;
+  std::mt19937 rng(35);
+  const char* words[] = {"a", "bc", "def", "ghij", "klmno"};
+  CPatchStr str("the quick brown fox jumps over the lazy dog");
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t edit = 1; edit <= edits; ++edit) {
+    size_t length = str.length();
+
+    if (rng() % 3 != 0 || length < 16)
+      str.insert(rng() % (length + 1), words[rng() % 5]);
+    else
+      str.remove(rng() % (length - 8), 1 + rng() % 8);
+
+    if (edit % report == 0) {
+      std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << "edits " << edit - report << "-" << edit << ": " << elapsed.count() / report << " ns/edit, "
+                << str.length() << " chars in " << str.patchCount() << " patches" << std::endl;
+      start = std::chrono::steady_clock::now();
+    }
+  }
+
+  auto measure = [&](const char* name, auto&& output) {
+    std::ostringstream oss;
+    auto output_start = std::chrono::steady_clock::now();
+    output(oss);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - output_start;
+    std::cout << name << " of " << oss.str().size() << " chars: " << elapsed.count() << " ms" << std::endl;
+  };
+
+  measure("toStr + write", [&](std::ostream& os) {
+    char* flat = str.toStr();
+    os.write(flat, static_cast<std::streamsize>(str.length()));
+    delete[] flat;
+  });
+  measure("writeTo", [&](std::ostream& os) {
+    str.writeTo(os);
+  });
+}
+
+void benchmarkCompaction() {
+  constexpr size_t edits = 500000, reads = 100000;
+  std::mt19937 rng(38);
+  const char* words[] = {"a", "bc", "def", "ghij", "klmno"};
+  CPatchStr str;
+  str.setAutoCompaction(false);
+  for (size_t edit = 0; edit < edits; ++edit)
+    str.insert(rng() % (str.length() + 1), words[rng() % 5]);
+
+  auto measure = [&](const char* state) {
+    CPatchStr::CFragmentation fragmentation = str.fragmentation();
+    auto start = std::chrono::steady_clock::now();
+    size_t checksum = 0;
+    for (std::string_view segment : str.segments())
+      checksum += segment.size();
+    std::chrono::duration<double, std::milli> iteration = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t read = 0; read < reads; ++read) {
+      char* substr = str.subStr(rng() % (str.length() - 64), 64).toStr();
+      checksum += static_cast<unsigned char>(substr[0]);
+      delete[] substr;
+    }
+    std::chrono::duration<double, std::nano> reading = std::chrono::steady_clock::now() - start;
+
+    std::cout << state << ": " << fragmentation.patch_count << " patches, " << fragmentation.small_patch_count
+              << " small, iteration " << iteration.count() << " ms, 64-char reads " << reading.count() / reads
+              << " ns/read (checksum " << checksum << ")" << std::endl;
+  };
+
+  measure("fragmented");
+  auto start = std::chrono::steady_clock::now();
+  str.compact();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "compaction of " << str.length() << " chars: " << elapsed.count() << " ms" << std::endl;
+  measure("compacted");
+}
+
+void benchmarkSearch() {
+  constexpr size_t edits = 500000, rounds = 20;
+  std::mt19937 rng(39);
+  const char* words[] = {"a", "bc", "def", "ghij", "klmno"};
+  CPatchStr fragmented;
+  fragmented.setAutoCompaction(false);
+  for (size_t edit = 0; edit < edits; ++edit)
+    fragmented.insert(rng() % (fragmented.length() + 1), words[rng() % 5]);
+  CPatchStr compacted(fragmented);
+  compacted.compact();
+  const char* needle = "klmnoklmnoklmnoklmno";
+
+  auto measure = [&](const char* name, auto&& workload) {
+    auto start = std::chrono::steady_clock::now();
+    size_t checksum = 0;
+    for (size_t round = 0; round < rounds; ++round)
+      checksum += workload();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "search " << name << ": " << elapsed.count() / rounds << " ms (checksum " << checksum << ")" << std::endl;
+  };
+
+  for (auto [str, other] : {std::pair(&fragmented, &compacted), std::pair(&compacted, &fragmented)}) {
+    std::cout << str->length() << " chars in " << str->patchCount() << " patches, compared with "
+              << other->patchCount() << " patches" << std::endl;
+    measure("toStr + strstr", [&]() {
+      std::unique_ptr<char[]> flat(str->toStr());
+      return static_cast<size_t>(std::strstr(flat.get(), needle) != nullptr);
+    });
+    measure("find", [&]() {
+      return static_cast<size_t>(str->find(needle) != CPatchStr::npos);
+    });
+    measure("toStr + strcmp", [&]() {
+      std::unique_ptr<char[]> x(str->toStr()), y(other->toStr());
+      return static_cast<size_t>(std::strcmp(x.get(), y.get()) == 0);
+    });
+    measure("compare", [&]() {
+      return static_cast<size_t>(str->compare(*other) == 0);
+    });
+    measure("hash", [&]() {
+      return str->hash();
+    });
+  }
+}
+
+#endif /* BENCHMARK */
+
 int main() {
-//  char tmpStr[100];
-//
-//  CPatchStr a ( "test" );
-//  assert ( stringMatch ( a . toStr (), "test" ) );
-//
-//  std::strncpy ( tmpStr, " da", sizeof ( tmpStr ) - 1 );
-//  a . append ( tmpStr );
-//  assert ( stringMatch ( a . toStr (), "test da" ) );
-//
-//  std::strncpy ( tmpStr, "ta", sizeof ( tmpStr ) - 1 );
-//  a . append ( tmpStr );
-//  assert ( stringMatch ( a . toStr (), "test data" ) );
-//
-//  std::strncpy ( tmpStr, "foo text", sizeof ( tmpStr ) - 1 );
-//  CPatchStr b ( tmpStr );
-//  assert ( stringMatch ( b . toStr (), "foo text" ) );
-//
-//  CPatchStr c ( a );
-//  assert ( stringMatch ( c . toStr (), "test data" ) );
-//
-//  CPatchStr d ( a . subStr ( 3, 5 ) );
-//  assert ( stringMatch ( d . toStr (), "t dat" ) );
-//
-//  d . append ( b );
-//  assert ( stringMatch ( d . toStr (), "t datfoo text" ) );
-//
-//  d . append ( b . subStr ( 3, 4 ) );
-//  assert ( stringMatch ( d . toStr (), "t datfoo text tex" ) );
-//
-//  c . append ( d );
-//  assert ( stringMatch ( c . toStr (), "test datat datfoo text tex" ) );
-//
-//  c . append ( c );
-//  assert ( stringMatch ( c . toStr (), "test datat datfoo text textest datat datfoo text tex" ) );
-//
-//  d . insert ( 2, c . subStr ( 6, 9 ) );
-//  assert ( stringMatch ( d . toStr (), "t atat datfdatfoo text tex" ) );
-//
-//  b = "abcdefgh";
-//  assert ( stringMatch ( b . toStr (), "abcdefgh" ) );
-//  assert ( stringMatch ( d . toStr (), "t atat datfdatfoo text tex" ) );
-//  assert ( stringMatch ( d . subStr ( 4, 8 ) . toStr (), "at datfd" ) );
-//  assert ( stringMatch ( b . subStr ( 2, 6 ) . toStr (), "cdefgh" ) );
-//
-//  try {
-//    b . subStr ( 2, 7 ) . toStr ();
-//    assert ( "Exception not thrown" == nullptr );
-//  } catch ( const std::out_of_range & e ) {
-//  } catch ( ... ) {
-//    assert ( "Invalid exception thrown" == nullptr );
-//  }
-//
-//  a . remove ( 3, 5 );
-//  assert ( stringMatch ( a . toStr (), "tesa" ) );
+  char tmpStr[100];
+
+  CPatchStr a ( "test" );
+  assert ( stringMatch ( a . toStr (), "test" ) );
+
+  std::strncpy ( tmpStr, " da", sizeof ( tmpStr ) - 1 );
+  a . append ( tmpStr );
+  assert ( stringMatch ( a . toStr (), "test da" ) );
+
+  std::strncpy ( tmpStr, "ta", sizeof ( tmpStr ) - 1 );
+  a . append ( tmpStr );
+  assert ( stringMatch ( a . toStr (), "test data" ) );
+
+  std::strncpy ( tmpStr, "foo text", sizeof ( tmpStr ) - 1 );
+  CPatchStr b ( tmpStr );
+  assert ( stringMatch ( b . toStr (), "foo text" ) );
+
+  CPatchStr c ( a );
+  assert ( stringMatch ( c . toStr (), "test data" ) );
+
+  CPatchStr d ( a . subStr ( 3, 5 ) );
+  assert ( stringMatch ( d . toStr (), "t dat" ) );
+
+  d . append ( b );
+  assert ( stringMatch ( d . toStr (), "t datfoo text" ) );
+
+  d . append ( b . subStr ( 3, 4 ) );
+  assert ( stringMatch ( d . toStr (), "t datfoo text tex" ) );
+
+  c . append ( d );
+  assert ( stringMatch ( c . toStr (), "test datat datfoo text tex" ) );
+
+  c . append ( c );
+  assert ( stringMatch ( c . toStr (), "test datat datfoo text textest datat datfoo text tex" ) );
+
+  d . insert ( 2, c . subStr ( 6, 9 ) );
+  assert ( stringMatch ( d . toStr (), "t atat datfdatfoo text tex" ) );
+
+  b = "abcdefgh";
+  assert ( stringMatch ( b . toStr (), "abcdefgh" ) );
+  assert ( stringMatch ( d . toStr (), "t atat datfdatfoo text tex" ) );
+  assert ( stringMatch ( d . subStr ( 4, 8 ) . toStr (), "at datfd" ) );
+  assert ( stringMatch ( b . subStr ( 2, 6 ) . toStr (), "cdefgh" ) );
+
+  try {
+    b . subStr ( 2, 7 ) . toStr ();
+    assert ( "Exception not thrown" == nullptr );
+  } catch ( const std::out_of_range & e ) {
+  } catch ( ... ) {
+    assert ( "Invalid exception thrown" == nullptr );
+  }
+
+  a . remove ( 3, 5 );
+  assert ( stringMatch ( a . toStr (), "tesa" ) );
+
+  a . insert ( 0, "<" ) . insert ( 5, ">" ) . insert ( 3, CPatchStr () );
+  assert ( stringMatch ( a . toStr (), "<tesa>" ) && a . length () == 6 && a . patchCount () == 4 );
+  assert ( stringMatch ( a . subStr ( 6, 0 ) . toStr (), "" ) );
+  a . remove ( 0, 6 );
+  assert ( stringMatch ( a . toStr (), "" ) && a . patchCount () == 0 );
+  assert ( stringMatch ( c . toStr (), "test datat datfoo text textest datat datfoo text tex" ) );
+
+  std::ostringstream oss;
+  oss << d;
+  assert ( oss . str () == "t atat datfdatfoo text tex" );
+  std::string joined;
+  for ( std::string_view segment : d . segments () )
+    joined += segment;
+  assert ( joined == "t atat datfdatfoo text tex" );
+  std::string_view segments[3];
+  size_t gathered = 0, first = 0;
+  for ( joined . clear (); ( gathered = d . gather ( segments, first ) ); first += gathered )
+    for ( size_t i = 0; i < gathered; ++i )
+      joined += segments[i];
+  assert ( joined == "t atat datfdatfoo text tex" && first == d . patchCount () );
+  CPatchStr two ( "abc" );
+  two . append ( "def" );
+  assert ( two . gather ( segments, two . patchCount () ) == 0 );
+  assert ( two . gather ( segments, 5 ) == 0 );
+  assert ( two . gather ( segments, 1 ) == 1 && segments[0] == "def" );
+  static_assert ( std::forward_iterator<CPatchStr::CSegmentIterator> );
+
+  CPatchStr fragmented, compacted;
+  fragmented . setAutoCompaction ( false );
+  for ( size_t i = 0; i < 2000; ++i ) {
+    fragmented . insert ( fragmented . length () / 2, i % 2 ? "ab" : "c" );
+    compacted . insert ( compacted . length () / 2, i % 2 ? "ab" : "c" );
+  }
+  CPatchStr::CFragmentation fragmentation = fragmented . fragmentation ();
+  assert ( fragmentation . length == 3000 && fragmentation . patch_count >= 2000 );
+  assert ( fragmentation . small_patch_count == fragmentation . patch_count && compacted . patchCount () < 1000 );
+  CPatchStr copy ( fragmented );
+  fragmented . compact ();
+  assert ( fragmented . patchCount () == 1 && fragmented . fragmentation () . small_patch_count == 0 );
+  assert ( copy . patchCount () == fragmentation . patch_count );
+  char* expected = copy . toStr ();
+  assert ( stringMatch ( fragmented . toStr (), expected ) && stringMatch ( compacted . toStr (), expected ) );
+  delete[] expected;
+
+  assert ( c . find ( "text tex" ) == 18 && c . find ( "text tex", 20 ) == 44 && c . find ( "t textest" ) == 21 );
+  assert ( c . find ( "datfoo", 12 ) == 37 && c . find ( "tex", 51 ) == CPatchStr::npos && c . find ( "aa" ) == CPatchStr::npos );
+  assert ( c . find ( "", 52 ) == 52 && c . find ( "t", 53 ) == CPatchStr::npos );
+  assert ( fragmented == copy && fragmented . hash () == copy . hash () && std::hash<CPatchStr> () ( compacted ) == copy . hash () );
+  assert ( c . subStr ( 26, 26 ) == c . subStr ( 0, 26 ) && c . subStr ( 26, 26 ) . compare ( c ) < 0 );
+  assert ( c . compare ( c . subStr ( 0, 51 ) ) > 0 && CPatchStr ( "abc" ) . compare ( "abd" ) < 0 && CPatchStr () . compare ( "" ) == 0 );
+
+  size_t sources = CSourcePool::instance () . size ();
+  {
+    CPatchStr x ( "pooled source" ), y ( "pooled source" );
+    x . append ( y . subStr ( 7, 6 ) );
+    y = "";
+    assert ( stringMatch ( x . toStr (), "pooled sourcesource" ) );
+    assert ( CSourcePool::instance () . size () == sources + 1 );
+  }
+  assert ( CSourcePool::instance () . size () == sources );
+
+  try {
+    d . insert ( 27, b );
+    assert ( "Exception not thrown" == nullptr );
+  } catch ( const std::out_of_range & e ) {
+  }
+
+#ifdef BENCHMARK
+  benchmarkEdits();
+  benchmarkCompaction();
+  benchmarkSearch();
+#endif /* BENCHMARK */
 
 	return EXIT_SUCCESS;
 }
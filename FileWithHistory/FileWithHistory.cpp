@@ -4,6 +4,14 @@
 #include <cstdio>
 #include <cstdint>
 #include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef BENCHMARK
+#include <chrono>
+#endif /* BENCHMARK */
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -14,34 +22,82 @@ using namespace std;
 
 /**
  * @brief CFile class to handle file operations including read, write, seek, truncate, version control, and undo operations.
+ *
+ * The file data is a persistent radix tree of fixed-size reference counted blocks. The file, its copies and its
+ * versions share the tree, a write copies only the path from the root to each block it touches. Versions form a tree
+ * as well, each one points to the version it was added after, so undo walks back along the branch while any version
+ * ever added stays reachable by its number.
  */
 class CFile
 {
 public:
 	CFile ()
-	: cf_DataVector(), cf_VersionVector(), cf_Position(0)
+	: cf_Contents(), cf_LastVersion(nullptr), cf_History(), cf_Position(0), cf_CheckpointInterval(0), cf_Sparse(false)
 	{
 	}
 
 	CFile (const CFile &source)
-	: cf_Position(source.cf_Position)
+	: cf_Contents(source.cf_Contents), cf_LastVersion(CVersion::share(source.cf_LastVersion)),
+	  cf_History(source.cf_History), cf_Position(source.cf_Position), cf_CheckpointInterval(source.cf_CheckpointInterval),
+	  cf_Sparse(source.cf_Sparse)
 	{
-		cf_DataVector = source.cf_DataVector;
-		cf_VersionVector = source.cf_VersionVector;
+		for (uint32_t i = 0; i < cf_History.size(); i++)
+			CVersion::share(cf_History[i]);
 	}
 
 	CFile &operator = (const CFile &source)
 	{
-		cf_DataVector = source.cf_DataVector;
-		cf_VersionVector = source.cf_VersionVector;
+		if (this == &source)
+			return *this;
+
+		release_versions();
+		cf_Contents = source.cf_Contents;
+		cf_LastVersion = CVersion::share(source.cf_LastVersion);
+		cf_History = source.cf_History;
+		for (uint32_t i = 0; i < cf_History.size(); i++)
+			CVersion::share(cf_History[i]);
 		cf_Position = source.cf_Position;
+		cf_CheckpointInterval = source.cf_CheckpointInterval;
+		cf_Sparse = source.cf_Sparse;
 		
 		return *this;
 	}
+
+	/**
+	 * @brief Take over the contents and versions of a file without touching any reference count.
+	 *
+	 * @param source The file to move from, left empty without versions.
+	 */
+	CFile (CFile &&source) noexcept
+	: cf_Contents(static_cast<CContents &&>(source.cf_Contents)), cf_LastVersion(source.cf_LastVersion),
+	  cf_History(static_cast<CVector<CVersion *> &&>(source.cf_History)), cf_Position(source.cf_Position),
+	  cf_CheckpointInterval(source.cf_CheckpointInterval), cf_Sparse(source.cf_Sparse)
+	{
+		source.cf_LastVersion = nullptr;
+		source.cf_Position = 0;
+	}
+
+	CFile &operator = (CFile &&source) noexcept
+	{
+		if (this == &source)
+			return *this;
+
+		release_versions();
+		cf_Contents = static_cast<CContents &&>(source.cf_Contents);
+		cf_LastVersion = source.cf_LastVersion;
+		cf_History = static_cast<CVector<CVersion *> &&>(source.cf_History);
+		cf_Position = source.cf_Position;
+		cf_CheckpointInterval = source.cf_CheckpointInterval;
+		cf_Sparse = source.cf_Sparse;
+		source.cf_LastVersion = nullptr;
+		source.cf_Position = 0;
+
+		return *this;
+	}
+
 	~CFile ()
 	{
-		cf_DataVector.clear();
-		cf_VersionVector.clear();
+		release_versions();
 		cf_Position = 0;
 	}
 
@@ -50,12 +106,12 @@ public:
 	/**
 	 * @brief Set the file position.
 	 *
-	 * @param offset The position to seek to.
+	 * @param offset The position to seek to, at most the file size unless the file is sparse.
 	 * @return True if the seek is successful, false otherwise.
 	 */
 	bool seek (const uint32_t offset)
 	{
-		if (offset < 0 || offset >= cf_DataVector.max_size())
+		if (!cf_Sparse && offset > cf_Contents.size())
 			return false;
 		cf_Position = offset;
 		return true;
@@ -72,9 +128,8 @@ public:
 	 */
 	uint32_t read (uint8_t *destination, const uint32_t bytes)
 	{
-		uint32_t read_bytes = 0;
-		for (size_t i = 0; i < bytes && cf_Position < cf_DataVector.size(); i++, read_bytes++)
-			destination[i] = cf_DataVector[cf_Position++];
+		uint32_t read_bytes = cf_Contents.read(cf_Position, destination, bytes);
+		cf_Position += read_bytes;
 		return read_bytes;
 	}
 
@@ -87,26 +142,57 @@ public:
 	 */
 	uint32_t write (const uint8_t *source, const uint32_t bytes)
 	{
-		uint32_t old_position = cf_Position;
-		for (size_t i = 0; i < bytes; i++, cf_Position++, source++)
-		{
-			if (cf_Position < cf_DataVector.size())
-				cf_DataVector.insert(cf_Position, *source);
-			else
-				cf_DataVector.push_back(*source);
-		}
-		return (cf_Position - old_position);
+		uint32_t written_bytes = cf_Contents.write(cf_Position, source, bytes);
+		cf_Position += written_bytes;
+		return written_bytes;
 	}
 
 	// -----------------------------------------------------------------------------------------------------------------
 
 	/**
-	 * @brief Truncate the file at the current position.
+	 * @brief Truncate the file at the current position, a position past the end of a sparse file extends it instead.
 	 */
 	void truncate ()
 	{
-		while (cf_DataVector.size() > cf_Position)
-			cf_DataVector.pop_back();
+		if (cf_Position == cf_Contents.size())
+			return;
+
+		cf_Contents.resize(cf_Position);
+	}
+
+	/**
+	 * @brief Allow seeking past the end of the file.
+	 *
+	 * Writing or truncating past the end then leaves a hole, it reads as zeros and takes no memory until written.
+	 *
+	 * @param sparse True to allow holes, false to limit seeking to the file size again.
+	 */
+	void setSparse (const bool sparse)
+	{
+		cf_Sparse = sparse;
+	}
+
+	/**
+	 * @brief Keep the file data in a memory-mapped scratch file instead of memory, so it may be larger than memory.
+	 *
+	 * The versions and the block tree stay in memory. Copies of the file and its versions share the scratch file, it is
+	 * removed when the last of them is destroyed.
+	 *
+	 * @param directory The directory for the scratch file.
+	 * @return True if the scratch file is created, false if it cannot be or the file already has data or versions.
+	 */
+	bool setBackingStore (const char *directory)
+	{
+		if (cf_Contents.size() || cf_LastVersion || !cf_History.is_empty())
+			return false;
+
+		CBlockStore *store = CBlockStore::open(directory);
+		if (!store)
+			return false;
+
+		cf_Contents = CContents(store);
+		CBlockStore::release(store);
+		return true;
 	}
 
 	// -----------------------------------------------------------------------------------------------------------------
@@ -118,37 +204,107 @@ public:
 	 */
 	uint32_t fileSize () const
 	{
-		return cf_DataVector.size();
+		return cf_Contents.size();
 	}
 
 	// -----------------------------------------------------------------------------------------------------------------
 
 	/**
-	 * @brief Add a new version of the file.
+	 * @brief Add a new version of the file, the version shares the current contents.
+	 *
+	 * With delta versions enabled, the version stores the bytes that differ from the version before it instead, unless
+	 * it is a checkpoint.
+	 *
+	 * @return The number of the new version, usable with checkoutVersion.
 	 */
-	void addVersion ()
+	uint32_t addVersion ()
 	{
-		cf_VersionVector.push_back(CVersion(cf_DataVector, cf_Position));
+		CVersion *version = new CVersion(cf_Contents, cf_Position, cf_LastVersion);
+		if (cf_LastVersion)
+		{
+			if (cf_LastVersion->get_chain() + 1 < cf_CheckpointInterval)
+				version->encode(cf_LastVersion->restore());
+			cf_LastVersion->drop_contents();
+		}
+
+		CVersion::release(cf_LastVersion);
+		cf_LastVersion = version;
+		cf_History.push_back(CVersion::share(version));
+
+		return cf_History.size() - 1;
 	}
 
 	/**
 	 * @brief Undo the last version of the file.
 	 *
+	 * The version stays in the history, only the current branch moves back to the version before it.
+	 *
 	 * @return True if the undo is successful, false otherwise.
 	 */
 	bool undoVersion ()
 	{
-		uint32_t array_size = cf_VersionVector.size();
-		if (array_size == 0)
+		if (!cf_LastVersion)
 			return false;
-		
-		cf_DataVector = cf_VersionVector[array_size - 1].get_datavector();
-		cf_Position = cf_VersionVector[array_size - 1].get_position();
-		cf_VersionVector.pop_back();
+
+		cf_Contents = cf_LastVersion->restore();
+		cf_Position = cf_LastVersion->get_position();
+		cf_LastVersion->drop_contents();
+
+		CVersion *parent = CVersion::share(cf_LastVersion->get_parent());
+		CVersion::release(cf_LastVersion);
+		cf_LastVersion = parent;
+
+		return true;
+	}
+
+	/**
+	 * @brief Restore any version ever added, further versions branch off it and the newer ones are kept.
+	 *
+	 * @param version The number returned by addVersion.
+	 * @return True if the version exists, false otherwise.
+	 */
+	bool checkoutVersion (const uint32_t version)
+	{
+		if (version >= cf_History.size())
+			return false;
+
+		CVersion *target = cf_History[version];
+		cf_Contents = target->restore();
+		cf_Position = target->get_position();
+
+		if (cf_LastVersion)
+			cf_LastVersion->drop_contents();
+		target->keep_contents(cf_Contents);
+		CVersion::share(target);
+		CVersion::release(cf_LastVersion);
+		cf_LastVersion = target;
 
 		return true;
 	}
 
+	/**
+	 * @brief Get the number of versions ever added.
+	 *
+	 * @return The number of versions.
+	 */
+	uint32_t versionCount () const
+	{
+		return cf_History.size();
+	}
+
+	/**
+	 * @brief Store the versions added from now on as deltas against the version before them.
+	 *
+	 * Restoring a delta version replays the deltas since the last full version, so every checkpoint_interval-th
+	 * version is kept in full to bound the work.
+	 *
+	 * @param checkpoint_interval The distance between full versions, 0 or 1 keeps every version in full.
+	 */
+	void setDeltaVersions (const uint32_t checkpoint_interval)
+	{
+		cf_CheckpointInterval = checkpoint_interval;
+	}
+
 private:
 	/**
 	 * @brief CVector template class to handle dynamic array operations.
@@ -157,14 +313,33 @@ private:
 	class CVector
 	{
 	public:
+		/**
+		 * @brief Create an empty vector, the array is allocated by the first insertion.
+		 */
 		CVector ()
-		: cvec_MaxSize(1), cvec_CurrentSize(0), cvec_Array(new T[cvec_MaxSize])
+		: cvec_MaxSize(0), cvec_CurrentSize(0), cvec_Array(nullptr)
+		{
+		}
+
+		CVector (const CVector &source)
+		: cvec_MaxSize(source.cvec_CurrentSize), cvec_CurrentSize(source.cvec_CurrentSize),
+		  cvec_Array(cvec_MaxSize ? new T[cvec_MaxSize] : nullptr)
+		{
+			for (size_t i = 0; i < cvec_CurrentSize; i++)
+				cvec_Array[i] = source.cvec_Array[i];
+		}
+
+		CVector (CVector &&source) noexcept
+		: cvec_MaxSize(source.cvec_MaxSize), cvec_CurrentSize(source.cvec_CurrentSize), cvec_Array(source.cvec_Array)
 		{
+			source.cvec_MaxSize = 0;
+			source.cvec_CurrentSize = 0;
+			source.cvec_Array = nullptr;
 		}
 
 		~CVector () 
 		{
-			cvec_MaxSize = 1;
+			cvec_MaxSize = 0;
 			cvec_CurrentSize = 0;
 			delete[] cvec_Array;
 			cvec_Array = nullptr;
@@ -180,17 +355,45 @@ private:
 		 */
 		CVector &operator = (const CVector &source)
 		{
-			cvec_MaxSize = source.cvec_MaxSize;
-			cvec_CurrentSize = source.cvec_CurrentSize;
-			delete[] cvec_Array;
+			if (this == &source)
+				return *this;
 
-			cvec_Array = new T[cvec_MaxSize];
+			if (cvec_MaxSize < source.cvec_CurrentSize)
+			{
+				delete[] cvec_Array;
+				cvec_MaxSize = source.cvec_CurrentSize;
+				cvec_Array = new T[cvec_MaxSize];
+			}
+
+			cvec_CurrentSize = source.cvec_CurrentSize;
 			for (size_t i = 0; i < cvec_CurrentSize; i++)
 				cvec_Array[i] = source.cvec_Array[i];
 
 			return *this;
 		}
 
+		/**
+		 * @brief Move assignment operator for CVector, the source is left empty.
+		 *
+		 * @param source The source vector to take the array from.
+		 * @return Reference to the assigned vector.
+		 */
+		CVector &operator = (CVector &&source) noexcept
+		{
+			if (this == &source)
+				return *this;
+
+			delete[] cvec_Array;
+			cvec_MaxSize = source.cvec_MaxSize;
+			cvec_CurrentSize = source.cvec_CurrentSize;
+			cvec_Array = source.cvec_Array;
+			source.cvec_MaxSize = 0;
+			source.cvec_CurrentSize = 0;
+			source.cvec_Array = nullptr;
+
+			return *this;
+		}
+
 		T &operator [] (const uint32_t idx) const
 		{
 			return cvec_Array[idx];
@@ -260,19 +463,45 @@ private:
 		void push_back (const T &data)
 		{
 			if (cvec_CurrentSize == cvec_MaxSize)
-			{
-				cvec_MaxSize *= 2;
+				reserve(cvec_CurrentSize + 1);
 
-				T *old_array = cvec_Array;
-				cvec_Array = new T[cvec_MaxSize];
+			cvec_Array[cvec_CurrentSize++] = data;
+		}
 
-				for (size_t i = 0; i < cvec_CurrentSize; i++)
-					cvec_Array[i] = old_array[i];
+		/**
+		 * @brief Add several elements to the end of the vector.
+		 *
+		 * @param data The elements to add.
+		 * @param count The number of elements.
+		 */
+		void append (const T *data, const uint32_t count)
+		{
+			reserve(cvec_CurrentSize + count);
+			for (uint32_t i = 0; i < count; i++)
+				cvec_Array[cvec_CurrentSize++] = data[i];
+		}
 
-				delete[] old_array;
-			}
+		/**
+		 * @brief Make room for at least the given number of elements with a single reallocation.
+		 *
+		 * The capacity at least doubles, so growing the vector piece by piece stays amortized constant.
+		 *
+		 * @param capacity The number of elements to make room for.
+		 */
+		void reserve (const uint32_t capacity)
+		{
+			if (capacity <= cvec_MaxSize)
+				return;
 
-			cvec_Array[cvec_CurrentSize++] = data;
+			cvec_MaxSize = capacity > 2 * cvec_MaxSize ? capacity : 2 * cvec_MaxSize;
+
+			T *old_array = cvec_Array;
+			cvec_Array = new T[cvec_MaxSize];
+
+			for (size_t i = 0; i < cvec_CurrentSize; i++)
+				cvec_Array[i] = static_cast<T &&>(old_array[i]);
+
+			delete[] old_array;
 		}
 
 		/**
@@ -302,7 +531,7 @@ private:
 		 */
 		void clear ()
 		{
-			cvec_MaxSize = 1;
+			cvec_MaxSize = 0;
 			cvec_CurrentSize = 0;
 			delete[] cvec_Array;
 			cvec_Array = nullptr;
@@ -317,108 +546,1386 @@ private:
 
 	// -----------------------------------------------------------------------------------------------------------------
 
+	static const uint32_t BLOCK_SIZE = 4096;
+	static const uint32_t FANOUT_BITS = 6;
+	static const uint32_t FANOUT = 1 << FANOUT_BITS;
+
 	/**
-	 * @brief CVersion class to handle version control of the file.
+	 * @brief CObjectPool class template keeping freed objects of a class for reuse, one pool per thread.
+	 *
+	 * A class routes its operator new and delete through the pool, so churning nodes and versions does not go to the
+	 * global allocator. A pooled object stores the next one at its start. The drain object frees the pool when the
+	 * thread exits and stops pooling, so objects freed later by static destructors go back to the global allocator.
 	 */
-	class CVersion
+	template <class T, uint32_t LIMIT>
+	class CObjectPool
 	{
 	public:
-		CVersion ()
-		: cver_DataVector(), cver_Position()
+		/**
+		 * @brief Take storage for an object from the pool, or from the global allocator if it is empty.
+		 *
+		 * @return The storage.
+		 */
+		static void *allocate ()
 		{
+			CState &state = instance();
+			if (!state.cop_Size)
+				return ::operator new(sizeof(T));
+
+			CFree *object = state.cop_Head;
+			state.cop_Head = object->cfre_Next;
+			state.cop_Size--;
+			return object;
 		}
 
-		CVersion (const CVector <uint8_t> &src_datavector, const uint32_t &src_position)
-		: cver_Position(src_position)
+		/**
+		 * @brief Return the storage of a destroyed object to the pool, or free it if the pool is full.
+		 *
+		 * @param storage The storage.
+		 */
+		static void deallocate (void *storage)
 		{
-			cver_DataVector = src_datavector;
+			CState &state = instance();
+			if (state.cop_Size >= state.cop_Limit)
+			{
+				::operator delete(storage);
+				return;
+			}
+
+			if (!state.cop_Size)
+				register_drain();
+
+			CFree *object = static_cast<CFree *>(storage);
+			object->cfre_Next = state.cop_Head;
+			state.cop_Head = object;
+			state.cop_Size++;
 		}
 
-		~CVersion ()
+	private:
+		struct CFree
+		{
+			CFree *cfre_Next;
+		};
+
+		struct CState
+		{
+			CFree *cop_Head;
+			uint32_t cop_Size;
+			uint32_t cop_Limit;
+		};
+
+		struct CDrain
+		{
+			~CDrain ()
+			{
+				CState &state = instance();
+				state.cop_Limit = 0;
+				while (state.cop_Head)
+				{
+					CFree *object = state.cop_Head;
+					state.cop_Head = object->cfre_Next;
+					::operator delete(object);
+				}
+				state.cop_Size = 0;
+			}
+		};
+
+		static CState &instance ()
 		{
-			cver_DataVector.clear();
-			cver_Position = 0;
+			thread_local CState state = {nullptr, 0, LIMIT};
+			return state;
 		}
 
-		// -------------------------------------------------------------------------------------------------------------
+		// the drain is created only once something is pooled, keeping its guard off the allocation path
+		static void register_drain ()
+		{
+			thread_local CDrain drain;
+			(void) drain;
+		}
 
-		/**
-		 * @brief Get the data vector of the version.
-		 *
-		 * @return Reference to the data vector.
-		 */
-		CVector <uint8_t> &get_datavector ()
+	};
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief CNode struct of the block tree, shared by reference counting.
+	 *
+	 * A node on level zero is a CBlock, a node above it is a CInner. The level is known from the height of the tree.
+	 */
+	struct CNode
+	{
+		uint32_t cnod_References;
+	};
+
+	/**
+	 * @brief CBlock struct holding a fixed-size chunk of the file data, kept in memory or in a CBlockStore.
+	 */
+	struct CBlock : CNode
+	{
+		uint8_t *cblk_Data;
+	};
+
+	/**
+	 * @brief CMemoryBlock struct of a block with its data right after the header.
+	 */
+	struct CMemoryBlock : CBlock
+	{
+		uint8_t cmbl_Storage[BLOCK_SIZE];
+
+		static void *operator new (size_t)
 		{
-			return cver_DataVector;
+			return CObjectPool<CMemoryBlock, 256>::allocate();
 		}
 
-		/**
-		 * @brief Get the position of the version.
-		 *
-		 * @return Reference to the position.
-		 */
-		uint32_t &get_position ()
+		static void operator delete (void *storage)
 		{
-			return cver_Position;
+			CObjectPool<CMemoryBlock, 256>::deallocate(storage);
 		}
+	};
 
-	private:
-		CVector <uint8_t> cver_DataVector;
-		uint32_t cver_Position;
+	/**
+	 * @brief CMappedBlock struct of a block with its data in a slot of the scratch file of a CBlockStore.
+	 */
+	struct CMappedBlock : CBlock
+	{
+		uint32_t cmap_Slot;
+
+		static void *operator new (size_t)
+		{
+			return CObjectPool<CMappedBlock, 4096>::allocate();
+		}
 
+		static void operator delete (void *storage)
+		{
+			CObjectPool<CMappedBlock, 4096>::deallocate(storage);
+		}
 	};
 
-	CVector <uint8_t> cf_DataVector;
-	CVector <CVersion> cf_VersionVector;
-	uint32_t cf_Position;
+	/**
+	 * @brief CInner struct holding the children of a tree node, the ones past the end of the file or in a hole are null.
+	 */
+	struct CInner : CNode
+	{
+		CNode *cinn_Children[FANOUT];
 
-};
+		static void *operator new (size_t)
+		{
+			return CObjectPool<CInner, 1024>::allocate();
+		}
 
-// ---------------------------------------------------------------------------------------------------------------------
-// ---------------------------------------------------------------------------------------------------------------------
+		static void operator delete (void *storage)
+		{
+			CObjectPool<CInner, 1024>::deallocate(storage);
+		}
+	};
 
-/**
- * @brief Helper function to test writing to the file.
- *
- * @param x The file object.
- * @param data The data to write.
- * @param wrLen The expected number of bytes written.
- * @return True if the test passes, false otherwise.
- */
-bool writeTest (CFile &x, const initializer_list<uint8_t> &data, uint32_t wrLen)
-{
-	return x.write(data.begin(), data.size()) == wrLen;
-}
+	// -----------------------------------------------------------------------------------------------------------------
 
-// ---------------------------------------------------------------------------------------------------------------------
+	static const uint32_t EXTENT_BLOCKS = 16384;
 
-/**
- * @brief Helper function to test reading from the file.
- *
- * @param x The file object.
- * @param data The expected data to read.
- * @param rdLen The expected number of bytes read.
- * @return True if the test passes, false otherwise.
-*/
-bool readTest (CFile &x, const initializer_list<uint8_t> &data, uint32_t rdLen)
-{
-	uint8_t tmp[100];
-	uint32_t idx = 0;
+	/**
+	 * @brief CBlockStore class keeping the data of blocks in a memory-mapped scratch file, shared by reference counting.
+	 *
+	 * The file is unlinked right after it is created and mapped in extents of EXTENT_BLOCKS blocks, so the data of a
+	 * block never moves. Only the block headers and the tree stay in memory, the page cache writes cold data back to the
+	 * file and evicts it.
+	 */
+	class CBlockStore
+	{
+	public:
+		CBlockStore (const CBlockStore &source) = delete;
+		CBlockStore &operator = (const CBlockStore &source) = delete;
 
-	if (x.read(tmp, rdLen) != data.size())
-		return false;
-	for (auto v : data)
-		if (tmp[idx++] != v)
-			return false;
-	return true;
-}
+		~CBlockStore ()
+		{
+			for (uint32_t i = 0; i < cbs_Extents.size(); i++)
+				munmap(cbs_Extents[i], size_t(EXTENT_BLOCKS) * BLOCK_SIZE);
+			close(cbs_File);
+		}
 
-// ---------------------------------------------------------------------------------------------------------------------
-// ---------------------------------------------------------------------------------------------------------------------
+		// -------------------------------------------------------------------------------------------------------------
 
-int main ( void )
-{
-  CFile f0;
+		/**
+		 * @brief Create a store with its scratch file in the given directory.
+		 *
+		 * @param directory The directory for the scratch file.
+		 * @return The store, null if the scratch file cannot be created.
+		 */
+		static CBlockStore *open (const char *directory)
+		{
+			char path[4096];
+			if (snprintf(path, sizeof(path), "%s/cfile-XXXXXX", directory) >= int(sizeof(path)))
+				return nullptr;
+
+			int file = mkstemp(path);
+			if (file < 0)
+				return nullptr;
+
+			unlink(path);
+			return new CBlockStore(file);
+		}
+
+		/**
+		 * @brief Add a reference to a store.
+		 *
+		 * @param store The store, may be null.
+		 * @return The shared store.
+		 */
+		static CBlockStore *share (CBlockStore *store)
+		{
+			if (store)
+				store->cbs_References++;
+			return store;
+		}
+
+		/**
+		 * @brief Drop a reference to a store, the last one closes it.
+		 *
+		 * @param store The store, may be null.
+		 */
+		static void release (CBlockStore *store)
+		{
+			if (store && --store->cbs_References == 0)
+				delete store;
+		}
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		/**
+		 * @brief Take a free slot of the scratch file for a new block, growing the file by an extent if there is none.
+		 *
+		 * @return The block, its data is undefined.
+		 */
+		CBlock *acquire ()
+		{
+			if (cbs_FreeSlots.is_empty())
+			{
+				if (cbs_NextSlot == cbs_Extents.size() * EXTENT_BLOCKS)
+					add_extent();
+				cbs_FreeSlots.push_back(cbs_NextSlot++);
+			}
+
+			CMappedBlock *block = new CMappedBlock;
+			block->cmap_Slot = cbs_FreeSlots.back();
+			block->cblk_Data = cbs_Extents[block->cmap_Slot / EXTENT_BLOCKS] + size_t(block->cmap_Slot % EXTENT_BLOCKS) * BLOCK_SIZE;
+			cbs_FreeSlots.pop_back();
+
+			return block;
+		}
+
+		/**
+		 * @brief Free the slot of a block no longer referenced.
+		 *
+		 * @param block The block.
+		 */
+		void recycle (CBlock *block)
+		{
+			CMappedBlock *mapped = static_cast<CMappedBlock *>(block);
+			cbs_FreeSlots.push_back(mapped->cmap_Slot);
+			delete mapped;
+		}
+
+	private:
+		uint32_t cbs_References;
+		int cbs_File;
+		CVector <uint8_t *> cbs_Extents;
+		CVector <uint32_t> cbs_FreeSlots;
+		uint32_t cbs_NextSlot;
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		explicit CBlockStore (const int file)
+		: cbs_References(1), cbs_File(file), cbs_Extents(), cbs_FreeSlots(), cbs_NextSlot(0)
+		{
+		}
+
+		/**
+		 * @brief Grow the scratch file by an extent and map it.
+		 *
+		 * The space is allocated up front, so running out of disk fails here instead of on a later access to the mapping.
+		 */
+		void add_extent ()
+		{
+			size_t extent_size = size_t(EXTENT_BLOCKS) * BLOCK_SIZE;
+			off_t offset = off_t(cbs_Extents.size()) * extent_size;
+
+			if (posix_fallocate(cbs_File, offset, extent_size))
+				throw bad_alloc();
+
+			void *extent = mmap(nullptr, extent_size, PROT_READ | PROT_WRITE, MAP_SHARED, cbs_File, offset);
+			if (extent == MAP_FAILED)
+				throw bad_alloc();
+
+			cbs_Extents.push_back(static_cast<uint8_t *>(extent));
+		}
+
+	};
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief CContents class holding the file data as a persistent tree of shared blocks.
+	 *
+	 * Copying the contents is constant time, the copies share the tree until one of them modifies it.
+	 */
+	class CContents
+	{
+	public:
+		CContents ()
+		: ccon_Root(nullptr), ccon_Height(0), ccon_Size(0), ccon_Store(nullptr)
+		{
+		}
+
+		/**
+		 * @brief Create empty contents keeping the data of their blocks in a store.
+		 *
+		 * @param store The store, null to keep the data in memory.
+		 */
+		explicit CContents (CBlockStore *store)
+		: ccon_Root(nullptr), ccon_Height(0), ccon_Size(0), ccon_Store(CBlockStore::share(store))
+		{
+		}
+
+		CContents (const CContents &source)
+		: ccon_Root(share_node(source.ccon_Root)), ccon_Height(source.ccon_Height), ccon_Size(source.ccon_Size),
+		  ccon_Store(CBlockStore::share(source.ccon_Store))
+		{
+		}
+
+		CContents &operator = (const CContents &source)
+		{
+			if (this == &source)
+				return *this;
+
+			CNode *root = share_node(source.ccon_Root);
+			CBlockStore *store = CBlockStore::share(source.ccon_Store);
+			release_node(ccon_Root, ccon_Height);
+			CBlockStore::release(ccon_Store);
+			ccon_Root = root;
+			ccon_Height = source.ccon_Height;
+			ccon_Size = source.ccon_Size;
+			ccon_Store = store;
+
+			return *this;
+		}
+
+		CContents (CContents &&source) noexcept
+		: ccon_Root(source.ccon_Root), ccon_Height(source.ccon_Height), ccon_Size(source.ccon_Size),
+		  ccon_Store(source.ccon_Store)
+		{
+			source.ccon_Root = nullptr;
+			source.ccon_Height = 0;
+			source.ccon_Size = 0;
+			source.ccon_Store = nullptr;
+		}
+
+		CContents &operator = (CContents &&source) noexcept
+		{
+			if (this == &source)
+				return *this;
+
+			release_node(ccon_Root, ccon_Height);
+			CBlockStore::release(ccon_Store);
+			ccon_Root = source.ccon_Root;
+			ccon_Height = source.ccon_Height;
+			ccon_Size = source.ccon_Size;
+			ccon_Store = source.ccon_Store;
+			source.ccon_Root = nullptr;
+			source.ccon_Height = 0;
+			source.ccon_Size = 0;
+			source.ccon_Store = nullptr;
+
+			return *this;
+		}
+
+		~CContents ()
+		{
+			release_node(ccon_Root, ccon_Height);
+			CBlockStore::release(ccon_Store);
+			ccon_Root = nullptr;
+			ccon_Store = nullptr;
+		}
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		/**
+		 * @brief Get the size of the data.
+		 *
+		 * @return The size in bytes.
+		 */
+		uint32_t size () const
+		{
+			return ccon_Size;
+		}
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		/**
+		 * @brief Read bytes block by block.
+		 *
+		 * @param position The position to read from.
+		 * @param destination The destination buffer.
+		 * @param bytes The maximum number of bytes to read.
+		 * @return The number of bytes read.
+		 */
+		uint32_t read (const uint32_t position, uint8_t *destination, const uint32_t bytes) const
+		{
+			uint32_t available = position < ccon_Size ? ccon_Size - position : 0;
+			uint32_t read_bytes = bytes < available ? bytes : available;
+
+			for (uint32_t done = 0; done < read_bytes; )
+			{
+				uint32_t offset = (position + done) % BLOCK_SIZE;
+				uint32_t chunk = BLOCK_SIZE - offset < read_bytes - done ? BLOCK_SIZE - offset : read_bytes - done;
+
+				const CBlock *block = find_block((position + done) / BLOCK_SIZE);
+				if (block)
+					memcpy(destination + done, block->cblk_Data + offset, chunk);
+				else
+					memset(destination + done, 0, chunk);
+				done += chunk;
+			}
+
+			return read_bytes;
+		}
+
+		/**
+		 * @brief Write bytes block by block, the shared nodes on the way to each block are copied first.
+		 *
+		 * @param position The position to write at, a hole is left between the size and a position past it.
+		 * @param source The source buffer.
+		 * @param bytes The maximum number of bytes to write, the data ends at UINT32_MAX at the latest.
+		 * @return The number of bytes written.
+		 */
+		uint32_t write (const uint32_t position, const uint8_t *source, uint32_t bytes)
+		{
+			if (bytes > UINT32_MAX - position)
+				bytes = UINT32_MAX - position;
+			if (bytes == 0)
+				return 0;
+			if (position > ccon_Size)
+				resize(position);
+
+			uint32_t end = position + bytes;
+			uint32_t block_count = blocks_for(end);
+
+			while (block_count > capacity(ccon_Height))
+			{
+				CInner *root = static_cast<CInner *>(new_node(1));
+				root->cinn_Children[0] = ccon_Root;
+				ccon_Root = root;
+				ccon_Height++;
+			}
+
+			for (uint32_t done = 0; done < bytes; )
+			{
+				uint32_t offset = (position + done) % BLOCK_SIZE;
+				uint32_t chunk = BLOCK_SIZE - offset < bytes - done ? BLOCK_SIZE - offset : bytes - done;
+
+				CBlock *block = writable_block((position + done) / BLOCK_SIZE, chunk < BLOCK_SIZE);
+				memcpy(block->cblk_Data + offset, source + done, chunk);
+				done += chunk;
+			}
+
+			if (end > ccon_Size)
+				ccon_Size = end;
+			return bytes;
+		}
+
+		/**
+		 * @brief Change the size of the data.
+		 *
+		 * Shrinking releases the blocks past the new end and shrinks the tree to fit, so it takes time proportional to
+		 * the blocks dropped. Growing leaves a hole that reads as zeros and takes no memory until written.
+		 *
+		 * @param size The new size.
+		 */
+		void resize (const uint32_t size)
+		{
+			if (size > ccon_Size)
+			{
+				// bytes past the old end may be left over from before a truncation
+				uint32_t offset = ccon_Size % BLOCK_SIZE;
+				if (offset && find_block(ccon_Size / BLOCK_SIZE))
+					memset(writable_block(ccon_Size / BLOCK_SIZE, true)->cblk_Data + offset, 0, BLOCK_SIZE - offset);
+
+				ccon_Size = size;
+				return;
+			}
+
+			uint32_t keep = blocks_for(size);
+			uint32_t total = blocks_for(ccon_Size);
+			if (total > capacity(ccon_Height))
+				total = capacity(ccon_Height);
+
+			if (keep == 0)
+			{
+				release_node(ccon_Root, ccon_Height);
+				ccon_Root = nullptr;
+				ccon_Height = 0;
+			}
+			else if (keep < total && ccon_Root)
+			{
+				trim_node(ccon_Root, ccon_Height, keep, total);
+				while (ccon_Height > 0 && keep <= capacity(ccon_Height - 1))
+				{
+					CNode *root = ccon_Root;
+					ccon_Root = share_node(static_cast<CInner *>(root)->cinn_Children[0]);
+					release_node(root, ccon_Height--);
+				}
+			}
+
+			ccon_Size = size;
+		}
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		/**
+		 * @brief Encode the difference from other contents as the new size followed by runs of bytes to write.
+		 *
+		 * Subtrees shared with the other contents are skipped without looking at their data, bytes past the size of the
+		 * other contents are compared with the zeros they read as after resizing.
+		 *
+		 * @param base The contents to compare with.
+		 * @param delta The vector to append the encoded difference to.
+		 */
+		void diff (const CContents &base, CVector <uint8_t> &delta) const
+		{
+			delta.append(reinterpret_cast<const uint8_t *>(&ccon_Size), sizeof(ccon_Size));
+
+			uint32_t last_run = 0;
+			uint32_t height = ccon_Height > base.ccon_Height ? ccon_Height : base.ccon_Height;
+			diff_node(base, base.ccon_Root, base.ccon_Height, ccon_Root, ccon_Height, height, 0, delta, last_run);
+		}
+
+		/**
+		 * @brief Turn the contents the difference was computed against into the ones it was computed from.
+		 *
+		 * @param delta The encoded difference.
+		 */
+		void patch (const CVector <uint8_t> &delta)
+		{
+			uint32_t run[2];
+
+			memcpy(run, &delta[0], sizeof(ccon_Size));
+			resize(run[0]);
+
+			for (uint32_t i = sizeof(ccon_Size); i < delta.size(); i += sizeof(run) + run[1])
+			{
+				memcpy(run, &delta[i], sizeof(run));
+				write(run[0], &delta[i + sizeof(run)], run[1]);
+			}
+		}
+
+	private:
+		/**
+		 * @brief Equal bytes between two differing ones shorter than a run header are included in the run.
+		 */
+		static const uint32_t DELTA_GAP = 8;
+
+		CNode *ccon_Root;
+		uint32_t ccon_Height;
+		uint32_t ccon_Size;
+		CBlockStore *ccon_Store;
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		/**
+		 * @brief Get the number of blocks a tree of the given height can hold.
+		 *
+		 * @param height The height of the tree.
+		 * @return The number of blocks.
+		 */
+		static uint32_t capacity (const uint32_t height)
+		{
+			return 1u << (FANOUT_BITS * height);
+		}
+
+		/**
+		 * @brief Get the number of blocks covering the given number of bytes, without wrapping near 4 GiB.
+		 *
+		 * @param bytes The number of bytes.
+		 * @return The number of blocks.
+		 */
+		static uint32_t blocks_for (const uint32_t bytes)
+		{
+			return static_cast<uint32_t>((static_cast<uint64_t>(bytes) + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		}
+
+		/**
+		 * @brief Find the block holding the data at the given block index.
+		 *
+		 * @param index The block index.
+		 * @return The block, null inside a hole.
+		 */
+		const CBlock *find_block (const uint32_t index) const
+		{
+			if (index >= capacity(ccon_Height))
+				return nullptr;
+
+			const CNode *node = ccon_Root;
+			for (uint32_t level = ccon_Height; level > 0 && node; level--)
+				node = static_cast<const CInner *>(node)->cinn_Children[(index >> (FANOUT_BITS * (level - 1))) & (FANOUT - 1)];
+			return static_cast<const CBlock *>(node);
+		}
+
+		/**
+		 * @brief Find the block at the given block index, copying or creating the nodes on the way as needed.
+		 *
+		 * @param index The block index, within the capacity of the tree.
+		 * @param preserve True if the data of a copied block is needed, false if it is about to be overwritten.
+		 * @return The block, owned only by these contents.
+		 */
+		CBlock *writable_block (const uint32_t index, const bool preserve)
+		{
+			CNode **slot = &ccon_Root;
+			for (uint32_t level = ccon_Height; ; level--)
+			{
+				CNode *node = *slot;
+				if (!node || node->cnod_References > 1)
+					*slot = node = own_node(node, level, preserve);
+				if (level == 0)
+					return static_cast<CBlock *>(node);
+				slot = &static_cast<CInner *>(node)->cinn_Children[(index >> (FANOUT_BITS * (level - 1))) & (FANOUT - 1)];
+			}
+		}
+
+		/**
+		 * @brief Release the blocks of a subtree past the given count, copying the nodes that change.
+		 *
+		 * @param node The root of the subtree.
+		 * @param level The level of the subtree.
+		 * @param keep The number of blocks to keep, not zero.
+		 * @param total The number of blocks in the subtree, more than keep.
+		 */
+		void trim_node (CNode *&node, const uint32_t level, const uint32_t keep, const uint32_t total)
+		{
+			node = own_node(node, level, true);
+
+			CInner *inner = static_cast<CInner *>(node);
+			uint32_t child_capacity = capacity(level - 1);
+			uint32_t kept_children = (keep + child_capacity - 1) / child_capacity;
+			uint32_t total_children = (total + child_capacity - 1) / child_capacity;
+
+			for (uint32_t i = kept_children; i < total_children; i++)
+			{
+				release_node(inner->cinn_Children[i], level - 1);
+				inner->cinn_Children[i] = nullptr;
+			}
+
+			uint32_t last_keep = keep - (kept_children - 1) * child_capacity;
+			uint32_t last_total = total - (kept_children - 1) * child_capacity;
+			if (last_total > child_capacity)
+				last_total = child_capacity;
+			if (last_keep < last_total && inner->cinn_Children[kept_children - 1])
+				trim_node(inner->cinn_Children[kept_children - 1], level - 1, last_keep, last_total);
+		}
+
+		/**
+		 * @brief Get a child of a node as seen from a higher level, a lower tree is the leftmost part of a higher one.
+		 *
+		 * @param node The node, may be null.
+		 * @param node_level The level of the node, at most level.
+		 * @param level The level the node is seen from, not zero.
+		 * @param index The index of the child.
+		 * @param child_level Set to the level of the child.
+		 * @return The child, may be null.
+		 */
+		static const CNode *child_at (const CNode *node, const uint32_t node_level, const uint32_t level, const uint32_t index,
+		                              uint32_t &child_level)
+		{
+			if (node_level < level)
+			{
+				child_level = node_level;
+				return index == 0 ? node : nullptr;
+			}
+
+			child_level = level - 1;
+			return node ? static_cast<const CInner *>(node)->cinn_Children[index] : nullptr;
+		}
+
+		/**
+		 * @brief Append the difference of two subtrees covering the same blocks to an encoded delta.
+		 *
+		 * @param base The contents compared with.
+		 * @param base_node The subtree of the base, may be null.
+		 * @param base_level The level of the base subtree.
+		 * @param node The subtree of these contents, may be null.
+		 * @param node_level The level of the subtree.
+		 * @param level The level both subtrees are seen from.
+		 * @param first_block The index of the first block covered.
+		 * @param delta The encoded delta.
+		 * @param last_run The position of the last run header in the delta, zero if none.
+		 */
+		void diff_node (const CContents &base, const CNode *base_node, const uint32_t base_level, const CNode *node,
+		                const uint32_t node_level, const uint32_t level, const uint32_t first_block,
+		                CVector <uint8_t> &delta, uint32_t &last_run) const
+		{
+			if (base_node == node && (!node || base_level == node_level))
+				return;
+
+			if (level > 0)
+			{
+				uint32_t child_capacity = capacity(level - 1);
+				for (uint32_t i = 0; i < FANOUT; i++)
+				{
+					uint32_t base_child_level, child_level;
+					const CNode *base_child = child_at(base_node, base_level, level, i, base_child_level);
+					const CNode *child = child_at(node, node_level, level, i, child_level);
+					if (!base_child && !child)
+						continue;
+
+					diff_node(base, base_child, base_child_level, child, child_level, level - 1,
+					          first_block + i * child_capacity, delta, last_run);
+				}
+				return;
+			}
+
+			static const uint8_t zeros[BLOCK_SIZE] = {};
+
+			uint32_t start = first_block * BLOCK_SIZE;
+			if (start >= ccon_Size)
+				return;
+
+			uint32_t length = ccon_Size - start < BLOCK_SIZE ? ccon_Size - start : BLOCK_SIZE;
+			uint32_t base_length = base.ccon_Size > start ? base.ccon_Size - start : 0;
+			if (base_length > BLOCK_SIZE)
+				base_length = BLOCK_SIZE;
+
+			const uint8_t *data = node ? static_cast<const CBlock *>(node)->cblk_Data : zeros;
+			const uint8_t *base_data = base_node ? static_cast<const CBlock *>(base_node)->cblk_Data : zeros;
+
+			uint8_t base_copy[BLOCK_SIZE];
+			if (base_length < length)
+			{
+				memcpy(base_copy, base_data, base_length);
+				memset(base_copy + base_length, 0, length - base_length);
+				base_data = base_copy;
+			}
+
+			for (uint32_t i = 0; i < length; )
+			{
+				if (data[i] == base_data[i])
+				{
+					i++;
+					continue;
+				}
+
+				uint32_t end = i + 1, j = end;
+				for (; j < length && j - end < DELTA_GAP; j++)
+					if (data[j] != base_data[j])
+						end = j + 1;
+
+				add_run(delta, last_run, start + i, data + i, end - i);
+				i = j;
+			}
+		}
+
+		/**
+		 * @brief Append a run of bytes to an encoded delta, extending the last run if it ends where this one starts.
+		 *
+		 * @param delta The encoded delta.
+		 * @param last_run The position of the last run header, zero if none, updated.
+		 * @param offset The position of the bytes in the contents.
+		 * @param data The bytes.
+		 * @param length The number of bytes.
+		 */
+		static void add_run (CVector <uint8_t> &delta, uint32_t &last_run, const uint32_t offset, const uint8_t *data,
+		                     const uint32_t length)
+		{
+			uint32_t run[2];
+
+			if (last_run)
+			{
+				memcpy(run, &delta[last_run], sizeof(run));
+				if (run[0] + run[1] == offset)
+				{
+					run[1] += length;
+					memcpy(&delta[last_run], run, sizeof(run));
+					delta.append(data, length);
+					return;
+				}
+			}
+
+			run[0] = offset;
+			run[1] = length;
+			last_run = delta.size();
+			delta.append(reinterpret_cast<const uint8_t *>(run), sizeof(run));
+			delta.append(data, length);
+		}
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		CNode *new_node (const uint32_t level)
+		{
+			CNode *node;
+			if (level > 0)
+			{
+				CInner *inner = new CInner;
+				memset(inner->cinn_Children, 0, sizeof(inner->cinn_Children));
+				node = inner;
+			}
+			else if (ccon_Store)
+				node = ccon_Store->acquire();
+			else
+			{
+				CMemoryBlock *block = new CMemoryBlock;
+				block->cblk_Data = block->cmbl_Storage;
+				node = block;
+			}
+
+			node->cnod_References = 1;
+			return node;
+		}
+
+		/**
+		 * @brief Make a node owned only by the caller, creating it if missing and copying it if shared.
+		 *
+		 * @param node The node, may be null.
+		 * @param level The level of the node.
+		 * @param preserve True if the data of a copied block is needed.
+		 * @return The owned node, replacing the given one.
+		 */
+		CNode *own_node (CNode *node, const uint32_t level, const bool preserve)
+		{
+			if (node && node->cnod_References == 1)
+				return node;
+
+			CNode *copy = new_node(level);
+			if (!node)
+			{
+				// a missing block is a hole, it reads as zeros
+				if (level == 0 && preserve)
+					memset(static_cast<CBlock *>(copy)->cblk_Data, 0, BLOCK_SIZE);
+				return copy;
+			}
+
+			if (level > 0)
+			{
+				const CInner *inner = static_cast<const CInner *>(node);
+				for (uint32_t i = 0; i < FANOUT; i++)
+					static_cast<CInner *>(copy)->cinn_Children[i] = share_node(inner->cinn_Children[i]);
+			}
+			else if (preserve)
+				memcpy(static_cast<CBlock *>(copy)->cblk_Data, static_cast<const CBlock *>(node)->cblk_Data, BLOCK_SIZE);
+
+			node->cnod_References--;
+			return copy;
+		}
+
+		static CNode *share_node (CNode *node)
+		{
+			if (node)
+				node->cnod_References++;
+			return node;
+		}
+
+		void release_node (CNode *node, const uint32_t level)
+		{
+			if (!node || --node->cnod_References > 0)
+				return;
+
+			if (level > 0)
+			{
+				CInner *inner = static_cast<CInner *>(node);
+				for (uint32_t i = 0; i < FANOUT; i++)
+					release_node(inner->cinn_Children[i], level - 1);
+				delete inner;
+			}
+			else if (ccon_Store)
+				ccon_Store->recycle(static_cast<CBlock *>(node));
+			else
+				delete static_cast<CMemoryBlock *>(node);
+		}
+
+	};
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief CVersion class to handle version control of the file, a reference counted node of the version tree.
+	 *
+	 * A version holds either its contents or a delta against its parent. A delta version keeps its contents too while
+	 * it is the last version of a file, so the next version can be encoded against it.
+	 */
+	class CVersion
+	{
+	public:
+		CVersion (const CContents &src_contents, const uint32_t src_position, CVersion *src_parent)
+		: cver_References(1), cver_Contents(src_contents), cver_Position(src_position), cver_Parent(share(src_parent)),
+		  cver_Delta(), cver_Chain(0), cver_Encoded(false), cver_HasContents(true)
+		{
+		}
+
+		CVersion (const CVersion &source) = delete;
+		CVersion &operator = (const CVersion &source) = delete;
+
+		static void *operator new (size_t)
+		{
+			return CObjectPool<CVersion, 1024>::allocate();
+		}
+
+		static void operator delete (void *storage)
+		{
+			CObjectPool<CVersion, 1024>::deallocate(storage);
+		}
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		/**
+		 * @brief Add a reference to a version.
+		 *
+		 * @param version The version, may be null.
+		 * @return The shared version.
+		 */
+		static CVersion *share (CVersion *version)
+		{
+			if (version)
+				version->cver_References++;
+			return version;
+		}
+
+		/**
+		 * @brief Drop a reference to a version, the last one deletes it and releases its parent.
+		 *
+		 * The parents are released in a loop, so a long history does not recurse.
+		 *
+		 * @param version The version, may be null.
+		 */
+		static void release (CVersion *version)
+		{
+			while (version && --version->cver_References == 0)
+			{
+				CVersion *parent = version->cver_Parent;
+				delete version;
+				version = parent;
+			}
+		}
+
+		// -------------------------------------------------------------------------------------------------------------
+
+		/**
+		 * @brief Encode the version as a delta against its parent.
+		 *
+		 * @param parent_contents The contents of the parent version.
+		 */
+		void encode (const CContents &parent_contents)
+		{
+			cver_Contents.diff(parent_contents, cver_Delta);
+			cver_Chain = cver_Parent->cver_Chain + 1;
+			cver_Encoded = true;
+		}
+
+		/**
+		 * @brief Get the contents of the version, replaying the deltas since the nearest version that has them.
+		 *
+		 * @return The contents.
+		 */
+		CContents restore () const
+		{
+			CVector <const CVersion *> chain;
+			const CVersion *version = this;
+			for (; !version->cver_HasContents; version = version->cver_Parent)
+				chain.push_back(version);
+
+			CContents contents = version->cver_Contents;
+			for (uint32_t i = chain.size(); i > 0; i--)
+				contents.patch(chain[i - 1]->cver_Delta);
+
+			return contents;
+		}
+
+		/**
+		 * @brief Keep the contents of a delta version until drop_contents.
+		 *
+		 * @param contents The contents of the version.
+		 */
+		void keep_contents (const CContents &contents)
+		{
+			if (!cver_Encoded)
+				return;
+
+			cver_Contents = contents;
+			cver_HasContents = true;
+		}
+
+		/**
+		 * @brief Release the contents of a delta version, they are restored from the delta when needed.
+		 */
+		void drop_contents ()
+		{
+			if (!cver_Encoded)
+				return;
+
+			cver_Contents = CContents();
+			cver_HasContents = false;
+		}
+
+		/**
+		 * @brief Get the number of deltas between the version and the nearest full version before it.
+		 *
+		 * @return The number of deltas.
+		 */
+		uint32_t get_chain () const
+		{
+			return cver_Chain;
+		}
+
+		/**
+		 * @brief Get the position of the version.
+		 *
+		 * @return The position.
+		 */
+		uint32_t get_position () const
+		{
+			return cver_Position;
+		}
+
+		/**
+		 * @brief Get the version this one was added after.
+		 *
+		 * @return The parent version, null for the first one.
+		 */
+		CVersion *get_parent () const
+		{
+			return cver_Parent;
+		}
+
+	private:
+		uint32_t cver_References;
+		CContents cver_Contents;
+		uint32_t cver_Position;
+		CVersion *cver_Parent;
+		CVector <uint8_t> cver_Delta;
+		uint32_t cver_Chain;
+		bool cver_Encoded;
+		bool cver_HasContents;
+
+	};
+
+	CContents cf_Contents;
+	CVersion *cf_LastVersion;
+	CVector <CVersion *> cf_History;
+	uint32_t cf_Position;
+	uint32_t cf_CheckpointInterval;
+	bool cf_Sparse;
+
+	// -----------------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Drop the references to the current branch and to the history.
+	 */
+	void release_versions ()
+	{
+		CVersion::release(cf_LastVersion);
+		cf_LastVersion = nullptr;
+		for (uint32_t i = 0; i < cf_History.size(); i++)
+			CVersion::release(cf_History[i]);
+	}
+
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Helper function to test writing to the file.
+ *
+ * @param x The file object.
+ * @param data The data to write.
+ * @param wrLen The expected number of bytes written.
+ * @return True if the test passes, false otherwise.
+ */
+bool writeTest (CFile &x, const initializer_list<uint8_t> &data, uint32_t wrLen)
+{
+	return x.write(data.begin(), data.size()) == wrLen;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Helper function to test reading from the file.
+ *
+ * @param x The file object.
+ * @param data The expected data to read.
+ * @param rdLen The expected number of bytes read.
+ * @return True if the test passes, false otherwise.
+*/
+bool readTest (CFile &x, const initializer_list<uint8_t> &data, uint32_t rdLen)
+{
+	uint8_t tmp[100];
+	uint32_t idx = 0;
+
+	if (x.read(tmp, rdLen) != data.size())
+		return false;
+	for (auto v : data)
+		if (tmp[idx++] != v)
+			return false;
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+#ifdef BENCHMARK
+
+static size_t g_live_bytes = 0;
+static size_t g_allocation_count = 0;
+
+// every allocation is prefixed with its size, so the live heap bytes can be tracked
+static const size_t ALLOCATION_HEADER = 16;
+
+void *operator new (size_t size)
+{
+	char *ptr = static_cast<char *>(malloc(size + ALLOCATION_HEADER));
+	if (!ptr)
+		throw bad_alloc();
+
+	*reinterpret_cast<size_t *>(ptr) = size;
+	g_live_bytes += size;
+	g_allocation_count++;
+	return ptr + ALLOCATION_HEADER;
+}
+
+// kept out of line, so GCC does not pair the inlined free with a new expression
+[[gnu::noinline]] void operator delete (void *ptr) noexcept
+{
+	if (!ptr)
+		return;
+
+	char *base = static_cast<char *>(ptr) - ALLOCATION_HEADER;
+	g_live_bytes -= *reinterpret_cast<size_t *>(base);
+	free(base);
+}
+
+[[gnu::noinline]] void operator delete (void *ptr, size_t) noexcept
+{
+	operator delete(ptr);
+}
+
+/**
+ * @brief Print the throughput of an operation.
+ *
+ * @param name The name of the operation.
+ * @param bytes The number of bytes moved.
+ * @param start The time the operation started at.
+ */
+static void reportThroughput (const char *name, const uint64_t bytes, const chrono::steady_clock::time_point &start)
+{
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	cout << name << ": " << bytes / elapsed.count() / (1024 * 1024) << " MB/s" << endl;
+}
+
+/**
+ * @brief Measure the throughput of sequential 1 MiB reads and writes and of random 64-byte writes.
+ *
+ * @param directory The directory for a backing store, null to keep the data in memory.
+ */
+static void benchmarkThroughput (const char *directory)
+{
+	const uint32_t chunk_size = 1024 * 1024, chunk_count = 64, small_size = 64, small_count = 1000000;
+	uint8_t *buffer = new uint8_t[chunk_size];
+	for (uint32_t i = 0; i < chunk_size; i++)
+		buffer[i] = i % 251;
+
+	cout << (directory ? "backing store:" : "memory:") << endl;
+
+	CFile file, scratch;
+	if (directory)
+	{
+		file.setBackingStore(directory);
+		scratch.setBackingStore(directory);
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < chunk_count; i++)
+		file.write(buffer, chunk_size);
+	reportThroughput("sequential 1 MiB writes", uint64_t(chunk_size) * chunk_count, start);
+
+	file.seek(0);
+	start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < chunk_count; i++)
+		file.read(buffer, chunk_size);
+	reportThroughput("sequential 1 MiB reads", uint64_t(chunk_size) * chunk_count, start);
+
+	uint32_t state = 2024;
+	start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < small_count; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		file.seek(state % (chunk_size * chunk_count - small_size));
+		file.write(buffer, small_size);
+	}
+	reportThroughput("random 64 B writes", uint64_t(small_size) * small_count, start);
+
+	start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < chunk_count; i++)
+	{
+		scratch.seek(0);
+		scratch.truncate();
+		scratch.write(buffer, chunk_size);
+	}
+	reportThroughput("truncate + 1 MiB rewrite", uint64_t(chunk_size) * chunk_count, start);
+
+	delete[] buffer;
+}
+
+/**
+ * @brief Measure adding versions after small writes to a large file and jumping between them.
+ */
+static void benchmarkVersions ()
+{
+	const uint32_t file_size = 16 * 1024 * 1024, small_size = 64, version_count = 10000;
+	uint8_t *buffer = new uint8_t[file_size];
+	for (uint32_t i = 0; i < file_size; i++)
+		buffer[i] = i % 251;
+
+	CFile file;
+	file.write(buffer, file_size);
+
+	uint32_t state = 2024;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < version_count; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		file.seek(state % (file_size - small_size));
+		file.write(buffer, small_size);
+		file.addVersion();
+	}
+	chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+	cout << "64 B write + addVersion on 16 MiB: " << elapsed.count() / version_count << " us" << endl;
+
+	start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < version_count; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		file.checkoutVersion(state % version_count);
+		file.read(buffer, small_size);
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "checkoutVersion + 64 B read: " << elapsed.count() / version_count << " us" << endl;
+
+	delete[] buffer;
+}
+
+/**
+ * @brief Measure the memory held by versions and the time to restore one for several checkpoint intervals.
+ *
+ * Each of the 10000 versions of a 10 MiB file differs from the one before it by four 8-byte writes scattered over
+ * the file.
+ */
+static void benchmarkDeltaVersions ()
+{
+	const uint32_t file_size = 10 * 1024 * 1024, version_count = 10000, restore_count = 1000;
+	uint8_t *buffer = new uint8_t[file_size];
+	for (uint32_t i = 0; i < file_size; i++)
+		buffer[i] = i % 251;
+
+	for (uint32_t interval : {0, 16, 64, 256, 1024})
+	{
+		CFile file;
+		file.write(buffer, file_size);
+		file.setDeltaVersions(interval);
+
+		uint32_t state = 2024;
+		size_t live_bytes = g_live_bytes;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (uint32_t i = 0; i < version_count; i++)
+		{
+			for (uint32_t j = 0; j < 4; j++)
+			{
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				file.seek(state % (file_size - 8));
+				file.write(buffer + j, 8);
+			}
+			file.addVersion();
+		}
+		chrono::duration<double, micro> add_elapsed = chrono::steady_clock::now() - start;
+		size_t version_bytes = g_live_bytes - live_bytes;
+
+		start = chrono::steady_clock::now();
+		for (uint32_t i = 0; i < restore_count; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			file.checkoutVersion(state % version_count);
+			file.read(buffer, 8);
+		}
+		chrono::duration<double, micro> restore_elapsed = chrono::steady_clock::now() - start;
+
+		cout << "checkpoint interval " << interval << ": " << version_bytes / (1024 * 1024) << " MiB for versions, "
+		     << add_elapsed.count() / version_count << " us/addVersion, " << restore_elapsed.count() / restore_count
+		     << " us/restore" << endl;
+	}
+
+	delete[] buffer;
+}
+
+/**
+ * @brief Count the heap allocations of copying a file with history, editing, versioning and moving the copy.
+ */
+static void benchmarkAllocations ()
+{
+	const uint32_t file_size = 1024 * 1024, version_count = 100, round_count = 10000;
+	uint8_t *buffer = new uint8_t[file_size];
+	for (uint32_t i = 0; i < file_size; i++)
+		buffer[i] = i % 251;
+
+	CFile file;
+	file.write(buffer, file_size);
+
+	uint32_t state = 2024;
+	for (uint32_t i = 0; i < version_count; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		file.seek(state % (file_size - 8));
+		file.write(buffer, 8);
+		file.addVersion();
+	}
+
+	size_t allocation_count = g_allocation_count;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (uint32_t i = 0; i < round_count; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		CFile copy(file);
+		copy.seek(state % (file_size - 64));
+		copy.write(buffer, 64);
+		copy.addVersion();
+		copy.undoVersion();
+
+		CFile moved(static_cast<CFile &&>(copy));
+		moved.addVersion();
+	}
+	chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+
+	cout << "copy + edit + version + move: " << double(g_allocation_count - allocation_count) / round_count
+	     << " allocations, " << elapsed.count() / round_count << " us" << endl;
+
+	delete[] buffer;
+}
+
+#endif /* BENCHMARK */
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main ( void )
+{
+  CFile f0;
 
   assert ( writeTest ( f0, { 10, 20, 30 }, 3 ) );
   assert ( f0 . fileSize () == 3 );
@@ -454,5 +1961,202 @@ int main ( void )
   assert ( readTest ( f1, { 4, 70, 80 }, 20 ));
   assert ( !f1 . undoVersion () );
 
+  CFile f2;
+  uint8_t block[10000];
+  for ( uint32_t i = 0; i < sizeof ( block ); i ++ )
+    block[i] = i % 251;
+  assert ( f2 . write ( block, sizeof ( block ) ) == sizeof ( block ) );
+  assert ( f2 . fileSize () == 10000 );
+  f2 . addVersion ();
+  CFile f3 ( f2 );
+  assert ( f2 . seek ( 4090 ));
+  assert ( writeTest ( f2, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }, 12 ) );
+  assert ( f2 . seek ( 4088 ));
+  assert ( readTest ( f2, { 72, 73, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 86 }, 15 ));
+  assert ( f3 . seek ( 4088 ));
+  assert ( readTest ( f3, { 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86 }, 15 ));
+  assert ( f2 . seek ( 4097 ));
+  f2 . truncate ();
+  assert ( f2 . fileSize () == 4097 );
+  assert ( f2 . seek ( 4095 ));
+  assert ( readTest ( f2, { 6, 7 }, 20 ));
+  assert ( f2 . undoVersion () );
+  assert ( f2 . fileSize () == 10000 );
+  assert ( f2 . seek ( 9998 ));
+  assert ( readTest ( f2, { 209, 210 }, 20 ));
+  assert ( f2 . seek ( 4090 ));
+  assert ( readTest ( f2, { 74, 75 }, 2 ));
+
+  CFile f4;
+  assert ( writeTest ( f4, { 1, 2, 3 }, 3 ) );
+  assert ( f4 . addVersion () == 0 );
+  assert ( writeTest ( f4, { 4 }, 1 ) );
+  assert ( f4 . addVersion () == 1 );
+  assert ( f4 . checkoutVersion ( 0 ));
+  assert ( f4 . fileSize () == 3 );
+  assert ( writeTest ( f4, { 9, 8 }, 2 ) );
+  assert ( f4 . addVersion () == 2 );
+  assert ( f4 . versionCount () == 3 );
+  assert ( f4 . checkoutVersion ( 1 ));
+  assert ( f4 . seek ( 0 ));
+  assert ( readTest ( f4, { 1, 2, 3, 4 }, 20 ));
+  assert ( f4 . checkoutVersion ( 2 ));
+  assert ( f4 . seek ( 0 ));
+  assert ( readTest ( f4, { 1, 2, 3, 9, 8 }, 20 ));
+  assert ( f4 . undoVersion () );
+  assert ( f4 . undoVersion () );
+  assert ( f4 . fileSize () == 3 );
+  assert ( !f4 . undoVersion () );
+  assert ( !f4 . checkoutVersion ( 3 ));
+  assert ( f4 . checkoutVersion ( 1 ));
+  assert ( f4 . fileSize () == 4 );
+
+  CFile f5;
+  for ( uint32_t i = 0; i < 300; i ++ )
+    assert ( f5 . write ( block, sizeof ( block ) ) == sizeof ( block ) );
+  assert ( f5 . fileSize () == 3000000 );
+  f5 . addVersion ();
+  assert ( f5 . seek ( 2999998 ));
+  assert ( readTest ( f5, { 209, 210 }, 20 ));
+  assert ( f5 . seek ( 5000 ));
+  f5 . truncate ();
+  assert ( f5 . fileSize () == 5000 );
+  assert ( writeTest ( f5, { 1, 2 }, 2 ) );
+  assert ( f5 . seek ( 4998 ));
+  assert ( readTest ( f5, { 229, 230, 1, 2 }, 20 ));
+  assert ( f5 . undoVersion () );
+  assert ( f5 . seek ( 4998 ));
+  assert ( readTest ( f5, { 229, 230, 231, 232 }, 4 ));
+  assert ( f5 . seek ( 2999998 ));
+  assert ( readTest ( f5, { 209, 210 }, 20 ));
+
+  CFile f6;
+  f6 . setDeltaVersions ( 4 );
+  assert ( f6 . write ( block, sizeof ( block ) ) == sizeof ( block ) );
+  for ( uint8_t i = 0; i < 10; i ++ )
+  {
+    assert ( f6 . seek ( i * 1000 + 5 ));
+    assert ( writeTest ( f6, { i }, 1 ) );
+    f6 . addVersion ();
+  }
+  assert ( f6 . seek ( 6000 ));
+  f6 . truncate ();
+  assert ( f6 . addVersion () == 10 );
+  assert ( f6 . checkoutVersion ( 3 ));
+  assert ( f6 . fileSize () == 10000 );
+  assert ( f6 . seek ( 3005 ));
+  assert ( readTest ( f6, { 3 }, 1 ));
+  assert ( f6 . seek ( 4005 ));
+  assert ( readTest ( f6, { 240 }, 1 ));
+  assert ( f6 . checkoutVersion ( 9 ));
+  assert ( f6 . seek ( 9005 ));
+  assert ( readTest ( f6, { 9 }, 1 ));
+  assert ( f6 . undoVersion () );
+  assert ( f6 . undoVersion () );
+  assert ( f6 . seek ( 8005 ));
+  assert ( readTest ( f6, { 8 }, 1 ));
+  assert ( f6 . seek ( 9005 ));
+  assert ( readTest ( f6, { 220 }, 1 ));
+  assert ( f6 . checkoutVersion ( 10 ));
+  assert ( f6 . fileSize () == 6000 );
+
+  CFile f7;
+  assert ( writeTest ( f7, { 1, 2, 3, 4 }, 4 ) );
+  assert ( !f7 . seek ( 10 ));
+  f7 . setSparse ( true );
+  assert ( f7 . seek ( 2 ));
+  f7 . truncate ();
+  assert ( f7 . seek ( 1000000000 ));
+  assert ( f7 . fileSize () == 2 );
+  assert ( readTest ( f7, {}, 10 ));
+  assert ( writeTest ( f7, { 7, 8, 9 }, 3 ) );
+  assert ( f7 . fileSize () == 1000000003 );
+  assert ( f7 . seek ( 0 ));
+  assert ( readTest ( f7, { 1, 2, 0, 0, 0 }, 5 ));
+  assert ( f7 . seek ( 500000000 ));
+  assert ( readTest ( f7, { 0, 0, 0 }, 3 ));
+  assert ( f7 . seek ( 999999998 ));
+  assert ( readTest ( f7, { 0, 0, 7, 8, 9 }, 20 ));
+  f7 . addVersion ();
+  assert ( f7 . seek ( 3000 ));
+  f7 . truncate ();
+  assert ( f7 . seek ( 5000 ));
+  f7 . truncate ();
+  assert ( f7 . fileSize () == 5000 );
+  assert ( f7 . seek ( 0 ));
+  assert ( readTest ( f7, { 1, 2, 0 }, 3 ));
+  assert ( f7 . undoVersion () );
+  assert ( f7 . fileSize () == 1000000003 );
+  assert ( f7 . seek ( 1000000001 ));
+  assert ( readTest ( f7, { 8, 9 }, 20 ));
+
+  CFile f11;
+  f11 . setSparse ( true );
+  assert ( writeTest ( f11, { 1, 2 }, 2 ) );
+  assert ( f11 . seek ( 0xFFFFFFF0 ));
+  assert ( writeTest ( f11, { 3, 4, 5, 6, 7, 8, 9, 10 }, 8 ) );
+  assert ( f11 . fileSize () == 0xFFFFFFF8 );
+  assert ( writeTest ( f11, { 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 }, 7 ) );
+  assert ( f11 . fileSize () == 0xFFFFFFFF );
+  assert ( writeTest ( f11, { 21 }, 0 ) );
+  assert ( f11 . seek ( 0 ));
+  assert ( readTest ( f11, { 1, 2, 0, 0 }, 4 ));
+  assert ( f11 . seek ( 0xFF0 ));
+  assert ( readTest ( f11, { 0, 0, 0, 0 }, 4 ));
+  assert ( f11 . seek ( 0xFFFFFFEF ));
+  assert ( readTest ( f11, { 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17 }, 20 ));
+  f11 . addVersion ();
+  assert ( f11 . seek ( 0xFFFFFFF4 ));
+  f11 . truncate ();
+  assert ( f11 . fileSize () == 0xFFFFFFF4 );
+  assert ( f11 . seek ( 0xFFFFFFF0 ));
+  assert ( readTest ( f11, { 3, 4, 5, 6 }, 20 ));
+  assert ( f11 . seek ( 0 ));
+  assert ( readTest ( f11, { 1, 2 }, 2 ));
+  assert ( f11 . undoVersion () );
+  assert ( f11 . fileSize () == 0xFFFFFFFF );
+
+  CFile f8;
+  assert ( !f8 . setBackingStore ( "/nonexistent-directory" ));
+  assert ( f8 . setBackingStore ( "/tmp" ));
+  for ( uint32_t i = 0; i < 10; i ++ )
+    assert ( f8 . write ( block, sizeof ( block ) ) == sizeof ( block ) );
+  f8 . addVersion ();
+  CFile f9 ( f8 );
+  assert ( f8 . seek ( 4090 ));
+  assert ( writeTest ( f8, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }, 12 ) );
+  assert ( !f8 . setBackingStore ( "/tmp" ));
+  assert ( f8 . seek ( 4088 ));
+  assert ( readTest ( f8, { 72, 73, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 86 }, 15 ));
+  assert ( f9 . seek ( 4088 ));
+  assert ( readTest ( f9, { 72, 73, 74, 75 }, 4 ));
+  assert ( f8 . undoVersion () );
+  assert ( f8 . fileSize () == 100000 );
+  assert ( f8 . seek ( 4090 ));
+  assert ( readTest ( f8, { 74, 75 }, 2 ));
+
+  CFile f10 ( static_cast<CFile &&> ( f9 ) );
+  assert ( f9 . fileSize () == 0 );
+  assert ( !f9 . undoVersion () );
+  assert ( f10 . seek ( 4088 ));
+  assert ( writeTest ( f10, { 1, 2 }, 2 ) );
+  assert ( f10 . undoVersion () );
+  assert ( f10 . seek ( 4088 ));
+  assert ( readTest ( f10, { 72, 73, 74, 75 }, 4 ));
+  f8 = static_cast<CFile &&> ( f10 );
+  assert ( f10 . fileSize () == 0 );
+  assert ( f8 . fileSize () == 100000 );
+  assert ( !f8 . undoVersion () );
+  assert ( f8 . seek ( 4090 ));
+  assert ( readTest ( f8, { 74, 75 }, 2 ));
+
+#ifdef BENCHMARK
+  benchmarkThroughput ( nullptr );
+  benchmarkThroughput ( "/tmp" );
+  benchmarkVersions ();
+  benchmarkDeltaVersions ();
+  benchmarkAllocations ();
+#endif /* BENCHMARK */
+
   return EXIT_SUCCESS;
 }
@@ -18,9 +18,15 @@
 #include <memory>
 #include <functional>
 #include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
 using namespace std;
 #endif /* __PROGTEST__ */
 
+#include <unordered_map>
+
 struct TNode
 {
 	// char t_Sign;
@@ -29,168 +35,116 @@ struct TNode
 	TNode *t_Right;
 };
 
-bool pushByte(vector<int> &v_byte, ifstream &ifs)
+// Reads bits from a buffer through a 64-bit accumulator, the first bit of a byte is its most significant one. Past the
+// end of the buffer it reads zeros and overrun() turns true.
+class CBitReader
 {
-	char ch_byte;
-	ifs.get(ch_byte);
-	if (ifs.fail())
-		return false;
-	for (int i = 7; i >= 0; i--)
-		v_byte.push_back((ch_byte >> i) & 1);
-	return true;
-}
+public:
+	CBitReader(const uint8_t *data, size_t size, uint64_t position = 0)
+	: br_Next(data + min<uint64_t>(position >> 3, size)), br_End(data + size), br_Position(position & ~uint64_t(7)),
+	  br_Limit(uint64_t(size) * 8)
+	{
+		refill();
+		consume(position & 7);
+	}
 
-uint8_t convertSign(vector<int> &v_byte)
-{
-	uint8_t int_sign = 0, base = 1;
-	for (int i = 7; i >= 0; i--)
+	// keeps at least 56 bits in the accumulator
+	void refill()
 	{
-		if (v_byte.at(i) == 1)
-			int_sign += base;
-		base *= 2;
+		// reloading a full accumulator changes nothing, so the reload does not branch on the bit count
+		if (br_End - br_Next >= 8)
+		{
+			uint64_t word;
+			memcpy(&word, br_Next, 8);
+			word = __builtin_bswap64(word);
+			// the accumulator bit at br_Count is the first bit of *br_Next, the bits past it are overwritten with the same values
+			br_Bits |= word >> br_Count;
+			br_Next += (63 - br_Count) >> 3;
+			br_Count |= 56;
+			return;
+		}
+
+		while (br_Count <= 56)
+		{
+			uint64_t byte = br_Next < br_End ? *br_Next++ : 0;
+			br_Bits |= byte << (56 - br_Count);
+			br_Count += 8;
+		}
 	}
-	return int_sign;
-}
 
-int convertSize(vector<int> &v_byte)
-{
-	int int_size = 0, base = 1;
-	for (int i = 11; i >= 0; i--)
+	// the next bits, at most 32 and at most as many as refill() guarantees
+	uint32_t peek(uint32_t bits) const
 	{
-		if (v_byte.at(i) == 1)
-			int_size += base;
-		base *= 2;
+		return (br_Bits >> 1) >> (63 - bits);
 	}
-	return int_size;
-}
 
-bool buildTree(TNode *&tree, vector<int> &v_byte, ifstream &ifs)
-{
-	if (v_byte.empty())
+	void consume(uint32_t bits)
 	{
-		if (!pushByte(v_byte, ifs))
-			return false;
+		br_Bits <<= bits;
+		br_Count -= bits;
+		br_Position += bits;
 	}
-	
-	if (v_byte.at(0) == 0)
+
+	uint32_t readBits(uint32_t bits)
 	{
-		v_byte.erase(v_byte.begin());
-		tree = new TNode();
-		if (!buildTree(tree->t_Left, v_byte, ifs))
-			return false;
-		if (!buildTree(tree->t_Right, v_byte, ifs))
-			return false;
-		return true;
+		refill();
+		uint32_t value = peek(bits);
+		consume(bits);
+		return value;
 	}
-	else if (v_byte.at(0) == 1)
+
+	uint64_t position() const
 	{
-		v_byte.erase(v_byte.begin());
-		if (v_byte.size() <= 8)
-		{
-			if (!pushByte(v_byte, ifs))
-				return false;
-		}
-		tree = new TNode();
-		if (v_byte.at(0) == 0)
-		{
-			vector<int> to_push;
-			for (size_t i = 0; i < 8; i++)
-				to_push.push_back(v_byte.at(i));
-			// copy(v_byte.begin(), v_byte.begin() + 8, to_push);
-			tree->t_Sign.push_back(convertSign(to_push));
-			v_byte.erase(v_byte.begin(), v_byte.begin() + 8);
-		}
-		else if (v_byte.at(0) == 1 && v_byte.at(1) == 1 && v_byte.at(2) == 0)
-		{
-			vector<int> to_push;
-			int count = 1;
-			for (int i = 0; i < 2; i++)
-			{
-				if (v_byte.size() <= 8)
-				{
-					if (!pushByte(v_byte, ifs) && count > 1 && !(v_byte.at(0) == 1 && v_byte.at(1) == 0))
-					{
-						delete tree;
-						return false;
-					}
-				}
-				// if (count > 1 && !(v_byte.at(0) == 1 && v_byte.at(1) == 0))
-				// {
-				// 	delete tree;
-				// 	return false;
-				// }
-				for (size_t i = 0; i < 8; i++)
-					to_push.push_back(v_byte.at(i));
-				// copy(v_byte.begin(), v_byte.begin() + 8, to_push);
-				tree->t_Sign.push_back(convertSign(to_push));
-				to_push.clear();
-				v_byte.erase(v_byte.begin(), v_byte.begin() + 8);
-				++count;
-			}
-		}
-		else if (v_byte.at(0) == 1 && v_byte.at(1) == 1 && v_byte.at(2) == 1 && v_byte.at(3) == 0)
-		{
-			vector<int> to_push;
-			int count = 1;
-			for (int i = 0; i < 3; i++)
-			{
-				if (v_byte.size() <= 8)
-				{
-					if (!pushByte(v_byte, ifs) && count > 1 && !(v_byte.at(0) == 1 && v_byte.at(1) == 0))
-					{
-						delete tree;
-						return false;
-					}
-				}
-				// if (count > 1 && !(v_byte.at(0) == 1 && v_byte.at(1) == 0))
-				// {
-				// 	delete tree;
-				// 	return false;
-				// }
-				for (size_t i = 0; i < 8; i++)
-					to_push.push_back(v_byte.at(i));
-				// copy(v_byte.begin(), v_byte.begin() + 8, to_push);
-				tree->t_Sign.push_back(convertSign(to_push));
-				to_push.clear();
-				v_byte.erase(v_byte.begin(), v_byte.begin() + 8);
-				++count;
-			}
-		}
-		else if (v_byte.at(0) == 1 && v_byte.at(1) == 1 && v_byte.at(2) == 1 && v_byte.at(3) == 1 && v_byte.at(4) == 0)
-		{
-			vector<int> to_push;
-			int count = 1;
-			for (int i = 0; i < 4; i++)
-			{
-				if (v_byte.size() <= 8)
-				{
-					if (!pushByte(v_byte, ifs) && count > 1 && !(v_byte.at(0) == 1 && v_byte.at(1) == 0))
-					{
-						delete tree;
-						return false;
-					}
-				}
-				// if (count > 1 && !(v_byte.at(0) == 1 && v_byte.at(1) == 0))
-				// {
-				// 	delete tree;
-				// 	return false;
-				// }
-				for (size_t i = 0; i < 8; i++)
-					to_push.push_back(v_byte.at(i));
-				// copy(v_byte.begin(), v_byte.begin() + 8, to_push);
-				tree->t_Sign.push_back(convertSign(to_push));
-				to_push.clear();
-				v_byte.erase(v_byte.begin(), v_byte.begin() + 8);
-				++count;
-			}
-		}
+		return br_Position;
+	}
 
-		// tree = new TNode();
-		// tree->t_Sign = char(convertSign(v_byte));
-		// v_byte.erase(v_byte.begin(), v_byte.begin() + 8);
-		return true;
+	bool overrun() const
+	{
+		return br_Position > br_Limit;
 	}
-	return true;
+
+private:
+	uint64_t br_Bits = 0;
+	uint32_t br_Count = 0;
+	const uint8_t *br_Next;
+	const uint8_t *br_End;
+	uint64_t br_Position;
+	uint64_t br_Limit;
+};
+
+// the number of bytes of the UTF-8 sequence starting with lead, 0 if lead cannot start one
+uint32_t utf8Size(uint8_t lead)
+{
+	return !(lead & 0x80) ? 1 : (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 0;
+}
+
+// A Huffman code of a text shorter than 2^64 characters is at most 92 bits long, a deeper tree is rejected before
+// the recursion here and in the decoder can exhaust the stack.
+const uint32_t MAX_TREE_DEPTH = 128;
+
+bool buildTree(TNode *&tree, CBitReader &reader, uint32_t depth = 0)
+{
+	// past the end of the input the zeros would read as inner nodes forever
+	if (reader.overrun() || depth > MAX_TREE_DEPTH)
+		return false;
+
+	tree = new TNode();
+	if (reader.readBits(1) == 0)
+		return buildTree(tree->t_Left, reader, depth + 1) && buildTree(tree->t_Right, reader, depth + 1);
+
+	uint8_t lead = reader.readBits(8);
+	uint32_t size = utf8Size(lead);
+	if (!size)
+		return false;
+	tree->t_Sign.push_back(lead);
+	for (uint32_t i = 1; i < size; i++)
+	{
+		uint8_t byte = reader.readBits(8);
+		if ((byte & 0xC0) != 0x80)
+			return false;
+		tree->t_Sign.push_back(byte);
+	}
+	return !reader.overrun();
 }
 
 // void showTree(TNode *&tmp)
@@ -206,97 +160,287 @@ bool buildTree(TNode *&tree, vector<int> &v_byte, ifstream &ifs)
 // 		showTree(tmp->t_Right);
 // }
 
-bool getSigns(TNode *&tree, vector<int> &v_byte, ifstream &ifs, ofstream &ofs)
+void deleteTree(TNode *&tmp)
+{
+	if (!tmp)
+		return;
+	if (tmp->t_Left)
+		deleteTree(tmp->t_Left);
+	if (tmp->t_Right)
+		deleteTree(tmp->t_Right);
+	delete tmp;
+}
+
+const uint32_t CHUNK_SIZE = 4096;
+const uint32_t PRIMARY_BITS = 11;
+const uint32_t SECONDARY_BITS = 6;
+// the compressor keeps codes within one subtable, unless the alphabet is too large for that
+const uint32_t MAX_CODE_BITS = PRIMARY_BITS + SECONDARY_BITS;
+
+struct TTableEntry
 {
-	if (!(tree->t_Left) && !(tree->t_Right))
+	// the UTF-8 code of a symbol and the length of its Huffman code, or a subtable and the number of bits indexing it
+	union
 	{
-		for (size_t i = 0; i < tree->t_Sign.size(); i++)
-		{
-			if (!ofs.put(tree->t_Sign.at(i)))
-				return false;
-		}
-		// ofs << tree->t_Sign;
-		// cout << tree->t_Sign;
-		if (ofs.fail() || !(ofs.is_open()))
-			return false;
-		return true;
-	}
+		uint8_t e_Sign[4];
+		uint32_t e_Subtable;
+	};
+	uint8_t e_Size;
+	uint8_t e_Length;
+	bool e_IsSubtable;
+};
 
-	if (v_byte.empty())
+// Decodes whole symbols per table lookup. The primary table is indexed by the next PRIMARY_BITS bits of the input,
+// codes longer than that continue in subtables indexed by the following SECONDARY_BITS bits.
+class CHuffmanDecoder
+{
+public:
+	bool build(const TNode *tree)
 	{
-		if (!pushByte(v_byte, ifs))
+		hd_Table.clear();
+		if (!tree)
 			return false;
+
+		hd_PrimaryBits = min(treeDepth(tree), PRIMARY_BITS);
+		uint32_t offset;
+		return buildTable(tree, hd_PrimaryBits, offset);
 	}
 
-	if (v_byte.at(0) == 0)
+	// writes the UTF-8 codes of the next count symbols to dst, which needs room for 4 * count + 4 bytes
+	char *decode(CBitReader &reader, uint32_t count, char *dst) const
 	{
-		v_byte.erase(v_byte.begin());
-		if (!getSigns(tree->t_Left, v_byte, ifs, ofs))
-			return false;
-		return true;
+		// a local copy of the reader stays in registers, the output may alias the original
+		CBitReader input = reader;
+		const TTableEntry *table = hd_Table.data();
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			input.refill();
+			uint32_t bits = hd_PrimaryBits;
+			TTableEntry entry = table[input.peek(bits)];
+			while (entry.e_IsSubtable)
+			{
+				input.consume(bits);
+				input.refill();
+				bits = entry.e_Length;
+				entry = table[entry.e_Subtable + input.peek(bits)];
+			}
+			input.consume(entry.e_Length);
+
+			memcpy(dst, entry.e_Sign, 4);
+			dst += entry.e_Size;
+		}
+
+		reader = input;
+		return dst;
 	}
-	else if (v_byte.at(0) == 1)
+
+private:
+	vector<TTableEntry> hd_Table;
+	uint32_t hd_PrimaryBits = 0;
+
+	static uint32_t treeDepth(const TNode *node)
 	{
-		v_byte.erase(v_byte.begin());
-		if (!getSigns(tree->t_Right, v_byte, ifs, ofs))
-			return false;
-		return true;
+		if (!node || (!(node->t_Left) && !(node->t_Right)))
+			return 0;
+		return 1 + max(treeDepth(node->t_Left), treeDepth(node->t_Right));
 	}
-	return true;
-}
 
-bool getChunk(TNode *&tree, vector<int> &v_byte, ifstream &ifs, ofstream &ofs)
-{
-	if (v_byte.empty())
+	bool buildTable(const TNode *node, uint32_t bits, uint32_t &offset)
 	{
-		if (!pushByte(v_byte, ifs))
-			return false;
+		offset = hd_Table.size();
+		hd_Table.resize(hd_Table.size() + (size_t(1) << bits));
+		return fillTable(node, offset, bits, 0, 0);
 	}
 
-	if (v_byte.at(0) == 0)
+	bool fillTable(const TNode *node, uint32_t offset, uint32_t bits, uint32_t depth, uint32_t prefix)
 	{
-		v_byte.erase(v_byte.begin());
-		while (v_byte.size() < 12)
+		if (!node)
+			return false;
+
+		if (!(node->t_Left) && !(node->t_Right))
 		{
-			if (!pushByte(v_byte, ifs))
+			TTableEntry entry = {};
+			if (!convertLeaf(node->t_Sign, entry))
 				return false;
+			entry.e_Length = depth;
+			// every index starting with the code of the leaf decodes to it
+			uint32_t first = offset + (prefix << (bits - depth)), last = first + (1u << (bits - depth));
+			for (uint32_t i = first; i < last; i++)
+				hd_Table[i] = entry;
+			return true;
 		}
-		int size_chunk = convertSize(v_byte);
-		// if (size_chunk == 0)
-		// 	return false;
-			 
-		v_byte.erase(v_byte.begin(), v_byte.begin() + 12);
-		for (int i = 0; i < size_chunk; i++)
+
+		if (depth == bits)
 		{
-			if (!getSigns(tree, v_byte, ifs, ofs))
+			uint32_t subtable;
+			if (!buildTable(node, SECONDARY_BITS, subtable))
 				return false;
+			hd_Table[offset + prefix].e_Subtable = subtable;
+			hd_Table[offset + prefix].e_Length = SECONDARY_BITS;
+			hd_Table[offset + prefix].e_IsSubtable = true;
+			return true;
 		}
-		return true;
+
+		return fillTable(node->t_Left, offset, bits, depth + 1, prefix << 1)
+			&& fillTable(node->t_Right, offset, bits, depth + 1, (prefix << 1) | 1);
 	}
-	else if (v_byte.at(0) == 1)
+
+	static bool convertLeaf(const vector<int> &sign, TTableEntry &entry)
 	{
-		v_byte.erase(v_byte.begin());
-		for (int i = 0; i < 4096; i++)
+		size_t size = sign.empty() ? 0 : utf8Size(sign.at(0));
+		if (!size || size != sign.size())
+			return false;
+
+		for (size_t i = 0; i < size; i++)
 		{
-			if (!getSigns(tree, v_byte, ifs, ofs))
+			if (i > 0 && (sign.at(i) & 0xC0) != 0x80)
 				return false;
+			entry.e_Sign[i] = sign.at(i);
 		}
-		if (!getChunk(tree, v_byte, ifs, ofs))
+		entry.e_Size = size;
+		return true;
+	}
+};
+
+bool getSigns(const CHuffmanDecoder &decoder, CBitReader &reader, uint32_t size_chunk, vector<char> &out)
+{
+	out.resize(size_chunk * 4 + 4);
+	char *end = decoder.decode(reader, size_chunk, out.data());
+	out.resize(end - out.data());
+	return !reader.overrun();
+}
+
+bool getChunk(const CHuffmanDecoder &decoder, CBitReader &reader, ofstream &ofs)
+{
+	vector<char> out;
+	while (true)
+	{
+		bool last = reader.readBits(1) == 0;
+		uint32_t size_chunk = last ? reader.readBits(12) : CHUNK_SIZE;
+		if (!getSigns(decoder, reader, size_chunk, out))
+			return false;
+		if (!ofs.write(out.data(), out.size()))
+			return false;
+		if (last)
+			return true;
+	}
+}
+
+// An optional trailer after the last chunk lists where every chunk starts, so the chunks can be decoded in parallel:
+// for each chunk the bit offset of its header in the file and the offset of its text in the output, then the number
+// of chunks, the size of the output and the magic, all 64-bit little-endian.
+const char CHUNK_INDEX_MAGIC[] = "HUFINDEX";
+const size_t CHUNK_INDEX_FOOTER = 24;
+
+struct TChunkStart
+{
+	uint64_t cs_Bits;
+	uint64_t cs_Text;
+};
+
+void appendUint64(vector<uint8_t> &bytes, uint64_t value)
+{
+	for (int i = 0; i < 8; i++)
+		bytes.push_back(value >> (8 * i));
+}
+
+uint64_t convertUint64(const uint8_t *bytes)
+{
+	uint64_t value = 0;
+	for (int i = 7; i >= 0; i--)
+		value = (value << 8) | bytes[i];
+	return value;
+}
+
+// Reads the chunk index from the end of the file data and shortens size to the chunks. Returns false if there is no
+// consistent index, the first chunk has to start at the bit first.
+bool readChunkIndex(const vector<uint8_t> &data, uint64_t first, size_t &size, vector<TChunkStart> &chunks,
+                    uint64_t &text_size)
+{
+	if (data.size() < CHUNK_INDEX_FOOTER || memcmp(data.data() + data.size() - 8, CHUNK_INDEX_MAGIC, 8))
+		return false;
+
+	const uint8_t *footer = data.data() + data.size() - CHUNK_INDEX_FOOTER;
+	uint64_t chunk_count = convertUint64(footer);
+	text_size = convertUint64(footer + 8);
+	if (!chunk_count || chunk_count > (data.size() - CHUNK_INDEX_FOOTER) / 16)
+		return false;
+
+	size = data.size() - CHUNK_INDEX_FOOTER - chunk_count * 16;
+	chunks.resize(chunk_count);
+	for (size_t i = 0; i < chunk_count; i++)
+	{
+		chunks[i].cs_Bits = convertUint64(data.data() + size + 16 * i);
+		chunks[i].cs_Text = convertUint64(data.data() + size + 16 * i + 8);
+	}
+
+	if (chunks[0].cs_Bits != first || chunks[0].cs_Text != 0)
+		return false;
+	for (size_t i = 0; i < chunk_count; i++)
+	{
+		uint64_t next_bits = i + 1 < chunk_count ? chunks[i + 1].cs_Bits : uint64_t(size) * 8;
+		uint64_t next_text = i + 1 < chunk_count ? chunks[i + 1].cs_Text : text_size;
+		if (chunks[i].cs_Bits >= next_bits || next_bits > uint64_t(size) * 8 || chunks[i].cs_Text > next_text
+			|| next_text - chunks[i].cs_Text > 4 * CHUNK_SIZE)
 			return false;
 	}
 	return true;
 }
 
-void deleteTree(TNode *&tmp)
+#ifndef __PROGTEST__
+// 0 decodes indexed files on every hardware thread
+size_t g_decompress_threads = 0;
+
+// Decodes the indexed chunks on a pool of threads, each into its slice of the preallocated output. Threads are not
+// available in the assignment build, indexed files are decoded one chunk after another there.
+bool getChunksParallel(const CHuffmanDecoder &decoder, const vector<uint8_t> &data, size_t size,
+                       const vector<TChunkStart> &chunks, uint64_t text_size, ofstream &ofs)
 {
-	if (!tmp)
-		return;
-	if (tmp->t_Left)
-		deleteTree(tmp->t_Left);
-	if (tmp->t_Right)
-		deleteTree(tmp->t_Right);
-	delete tmp;
+	vector<char> text(text_size);
+	atomic<size_t> next_chunk(0);
+	atomic<bool> failed(false);
+
+	auto worker = [&]()
+	{
+		vector<char> out;
+		for (size_t i = next_chunk++; i < chunks.size() && !failed; i = next_chunk++)
+		{
+			bool last = i + 1 == chunks.size();
+			uint64_t end_bits = last ? uint64_t(size) * 8 : chunks[i + 1].cs_Bits;
+			uint64_t end_text = last ? text_size : chunks[i + 1].cs_Text;
+
+			CBitReader reader(data.data(), size, chunks[i].cs_Bits);
+			if ((reader.readBits(1) == 0) != last)
+			{
+				failed = true;
+				return;
+			}
+			uint32_t size_chunk = last ? reader.readBits(12) : CHUNK_SIZE;
+
+			// a symbol may write past its text, so the chunk is decoded aside and copied into its slice
+			if (!getSigns(decoder, reader, size_chunk, out) || out.size() != end_text - chunks[i].cs_Text
+				|| (last ? reader.position() > end_bits : reader.position() != end_bits))
+			{
+				failed = true;
+				return;
+			}
+			memcpy(text.data() + chunks[i].cs_Text, out.data(), out.size());
+		}
+	};
+
+	size_t threads = g_decompress_threads ? g_decompress_threads : max(1u, thread::hardware_concurrency());
+	threads = min(threads, chunks.size());
+	vector<thread> pool;
+	for (size_t i = 1; i < threads; i++)
+		pool.emplace_back(worker);
+	worker();
+	for (thread &t : pool)
+		t.join();
+
+	return !failed && ofs.write(text.data(), text.size());
 }
+#endif /* __PROGTEST__ */
 
 bool decompressFile ( const char * inFileName, const char * outFileName )
 {
@@ -308,71 +452,665 @@ bool decompressFile ( const char * inFileName, const char * outFileName )
 		return false;
 	}
 
-	vector<int> v_byte;
-	TNode *tree = nullptr;
-	if (!buildTree(tree, v_byte, ifs))
+	// the whole file is read at once, the tree and the chunks are decoded from memory
+	ifs.seekg(0, ios::end);
+	vector<uint8_t> data(max<streamoff>(ifs.tellg(), 0));
+	ifs.seekg(0);
+	if (!ifs.read(reinterpret_cast<char *>(data.data()), data.size()))
 	{
-		deleteTree(tree);
 		ifs.close();
 		return false;
 	}
+	ifs.close();
+
+	CBitReader reader(data.data(), data.size());
+	TNode *tree = nullptr;
+	bool built = buildTree(tree, reader);
 	// showTree(tree);
+	CHuffmanDecoder decoder;
+	built = built && decoder.build(tree);
+	deleteTree(tree);
+	if (!built)
+		return false;
+
 	ofstream ofs(outFileName, ios::binary);
-	if (!getChunk(tree, v_byte, ifs, ofs))
+	bool decoded;
+#ifndef __PROGTEST__
+	size_t size = data.size();
+	vector<TChunkStart> chunks;
+	uint64_t text_size;
+	if (readChunkIndex(data, reader.position(), size, chunks, text_size))
+		decoded = getChunksParallel(decoder, data, size, chunks, text_size, ofs);
+	else
+#endif /* __PROGTEST__ */
+		decoded = getChunk(decoder, reader, ofs);
+
+	if (!decoded || !(ofs.is_open()) || ofs.fail() || !ofs)
 	{
-		deleteTree(tree);
-		ifs.close();
 		ofs.close();
 		remove(outFileName);
 		return false;
 	}
-	if (!(ofs.is_open()) || ofs.fail() || !ofs)
+	return true;
+}
+
+// Reads UTF-8 sequences from a stream in large blocks.
+class CUtf8Reader
+{
+public:
+	explicit CUtf8Reader(ifstream &ifs) : ur_Stream(ifs), ur_Buffer(BLOCK_SIZE)
+	{
+	}
+
+	// stores the bytes of the next sequence in key, the first byte lowest, returns false at the end of the input
+	// or at an invalid sequence
+	bool next(uint32_t &key, uint32_t &size)
+	{
+		if (ur_End - ur_Next < 4 && !fill())
+			return false;
+
+		uint8_t lead = ur_Buffer[ur_Next];
+		size = utf8Size(lead);
+		if (!size || ur_End - ur_Next < size)
+		{
+			ur_Invalid = true;
+			return false;
+		}
+
+		key = lead;
+		for (uint32_t i = 1; i < size; i++)
+		{
+			uint8_t byte = ur_Buffer[ur_Next + i];
+			if ((byte & 0xC0) != 0x80)
+			{
+				ur_Invalid = true;
+				return false;
+			}
+			key |= uint32_t(byte) << (8 * i);
+		}
+		ur_Next += size;
+		return true;
+	}
+
+	bool invalid() const
+	{
+		return ur_Invalid || ur_Stream.bad();
+	}
+
+private:
+	static const size_t BLOCK_SIZE = 1 << 16;
+
+	ifstream &ur_Stream;
+	vector<uint8_t> ur_Buffer;
+	size_t ur_Next = 0;
+	size_t ur_End = 0;
+	bool ur_Invalid = false;
+
+	// moves the unread bytes to the front and reads more after them, returns false if no bytes are left
+	bool fill()
+	{
+		size_t rest = ur_End - ur_Next;
+		memmove(ur_Buffer.data(), ur_Buffer.data() + ur_Next, rest);
+		ur_Next = 0;
+		ur_End = rest;
+		if (ur_Stream.good())
+		{
+			ur_Stream.read(reinterpret_cast<char *>(ur_Buffer.data()) + rest, BLOCK_SIZE - rest);
+			ur_End += ur_Stream.gcount();
+		}
+		return ur_End > 0;
+	}
+};
+
+// Collects bits in a 64-bit buffer and writes them to a stream in large blocks, the first bit is the most significant
+// one of its byte.
+class CBitWriter
+{
+public:
+	explicit CBitWriter(ofstream &ofs) : bw_Stream(ofs)
+	{
+		bw_Buffer.reserve(BLOCK_SIZE + 4);
+	}
+
+	// bits is at most 32
+	void writeBits(uint32_t value, uint32_t bits)
+	{
+		bw_Bits |= (uint64_t(value) << 1) << (63 - bw_Count - bits);
+		bw_Count += bits;
+		if (bw_Count < 32)
+			return;
+
+		uint32_t word = bw_Bits >> 32;
+		uint8_t bytes[4] = {uint8_t(word >> 24), uint8_t(word >> 16), uint8_t(word >> 8), uint8_t(word)};
+		bw_Buffer.insert(bw_Buffer.end(), bytes, bytes + 4);
+		bw_Bits <<= 32;
+		bw_Count -= 32;
+		if (bw_Buffer.size() >= BLOCK_SIZE)
+			flush();
+	}
+
+	// the number of bits written so far
+	uint64_t position() const
+	{
+		return (bw_Written + bw_Buffer.size()) * 8 + bw_Count;
+	}
+
+	// pads the last byte with zeros and writes everything out
+	bool finish()
+	{
+		while (bw_Count > 0)
+		{
+			bw_Buffer.push_back(bw_Bits >> 56);
+			bw_Bits <<= 8;
+			bw_Count = bw_Count > 8 ? bw_Count - 8 : 0;
+		}
+		flush();
+		return bw_Stream.good();
+	}
+
+private:
+	static const size_t BLOCK_SIZE = 1 << 16;
+
+	ofstream &bw_Stream;
+	vector<uint8_t> bw_Buffer;
+	uint64_t bw_Bits = 0;
+	uint32_t bw_Count = 0;
+	uint64_t bw_Written = 0;
+
+	void flush()
+	{
+		bw_Stream.write(reinterpret_cast<const char *>(bw_Buffer.data()), bw_Buffer.size());
+		bw_Written += bw_Buffer.size();
+		bw_Buffer.clear();
+	}
+};
+
+struct TCode
+{
+	uint32_t c_Key;
+	uint8_t c_Size;
+	uint8_t c_Length;
+	uint32_t c_Code;
+	uint64_t c_Count;
+};
+
+// Package-merge: sets the lengths of an optimal prefix code of at most limit bits for codes sorted by count, at least
+// two and at most 2^limit of them. A leaf taken at a level of the merge gets one bit longer, packages taken at a level
+// are made of twice as many items at the level below.
+void limitCodeLengths(vector<TCode> &codes, uint32_t limit)
+{
+	size_t n = codes.size();
+	vector<vector<bool>> packaged(limit);
+	vector<uint64_t> items, packages;
+	for (size_t i = 0; i < n; i++)
+		items.push_back(codes[i].c_Count);
+
+	for (uint32_t level = limit - 1; level > 0; level--)
+	{
+		packages.clear();
+		for (size_t i = 0; i + 1 < items.size(); i += 2)
+			packages.push_back(items[i] + items[i + 1]);
+
+		items.clear();
+		size_t leaf = 0, package = 0;
+		while (leaf < n || package < packages.size())
+		{
+			bool take_package = package < packages.size() && (leaf == n || packages[package] < codes[leaf].c_Count);
+			items.push_back(take_package ? packages[package++] : codes[leaf++].c_Count);
+			packaged[level - 1].push_back(take_package);
+		}
+	}
+
+	for (size_t i = 0; i < n; i++)
+		codes[i].c_Length = 0;
+	size_t taken = 2 * n - 2;
+	for (uint32_t level = 0; level < limit; level++)
+	{
+		size_t leaves = taken, package_items = 0;
+		if (level + 1 < limit)
+		{
+			leaves = 0;
+			for (size_t i = 0; i < taken; i++)
+				packaged[level][i] ? package_items += 2 : leaves++;
+		}
+		for (size_t i = 0; i < leaves; i++)
+			codes[i].c_Length++;
+		taken = package_items;
+	}
+}
+
+// Writes the tree of canonical codes sorted by length and code in pre-order, as buildTree reads it.
+void writeTree(CBitWriter &writer, const vector<TCode> &codes, size_t begin, size_t end, uint32_t depth)
+{
+	if (end - begin == 1 && codes[begin].c_Length == depth)
+	{
+		writer.writeBits(1, 1);
+		for (uint32_t i = 0; i < codes[begin].c_Size; i++)
+			writer.writeBits((codes[begin].c_Key >> (8 * i)) & 0xFF, 8);
+		return;
+	}
+
+	// the codes with a zero bit after the first depth bits come first
+	size_t split = begin;
+	while (split < end && !((codes[split].c_Code >> (codes[split].c_Length - depth - 1)) & 1))
+		split++;
+	writer.writeBits(0, 1);
+	writeTree(writer, codes, begin, split, depth + 1);
+	writeTree(writer, codes, split, end, depth + 1);
+}
+
+// chunk_index appends the index of the chunks, so decompressFile can decode them in parallel
+bool compressFile ( const char * inFileName, const char * outFileName, bool chunk_index = false )
+{
+	ifstream ifs(inFileName, ios::binary);
+	if (ifs.fail() || !(ifs.is_open()))
+		return false;
+
+	// the first pass counts the symbols
+	uint64_t ascii_counts[128] = {};
+	unordered_map<uint32_t, TCode> counts;
+	uint64_t symbol_count = 0;
+	{
+		CUtf8Reader reader(ifs);
+		uint32_t key, size;
+		while (reader.next(key, size))
+		{
+			if (size == 1)
+				ascii_counts[key]++;
+			else
+			{
+				TCode &symbol = counts[key];
+				symbol.c_Key = key;
+				symbol.c_Size = size;
+				symbol.c_Count++;
+			}
+			symbol_count++;
+		}
+		if (reader.invalid() || !symbol_count)
+			return false;
+	}
+
+	vector<TCode> codes;
+	for (uint32_t key = 0; key < 128; key++)
+		if (ascii_counts[key])
+			codes.push_back({key, 1, 0, 0, ascii_counts[key]});
+	for (const pair<const uint32_t, TCode> &count : counts)
+		codes.push_back(count.second);
+
+	// a single symbol is a tree of just a leaf, its code has no bits
+	if (codes.size() > 1)
+	{
+		sort(codes.begin(), codes.end(), [](const TCode &a, const TCode &b)
+		{
+			return a.c_Count != b.c_Count ? a.c_Count < b.c_Count : a.c_Key < b.c_Key;
+		});
+		uint32_t limit = MAX_CODE_BITS;
+		while ((uint64_t(1) << limit) < codes.size())
+			limit++;
+		limitCodeLengths(codes, limit);
+	}
+
+	sort(codes.begin(), codes.end(), [](const TCode &a, const TCode &b)
+	{
+		return a.c_Length != b.c_Length ? a.c_Length < b.c_Length : a.c_Key < b.c_Key;
+	});
+	uint32_t code = 0;
+	for (size_t i = 0; i < codes.size(); i++)
+	{
+		if (i > 0)
+			code = (code + 1) << (codes[i].c_Length - codes[i - 1].c_Length);
+		codes[i].c_Code = code;
+	}
+
+	TCode ascii_codes[128] = {};
+	for (const TCode &symbol : codes)
+	{
+		if (symbol.c_Size == 1)
+			ascii_codes[symbol.c_Key] = symbol;
+		else
+			counts[symbol.c_Key] = symbol;
+	}
+
+	// the second pass writes the tree and the chunks
+	ofstream ofs(outFileName, ios::binary);
+	if (ofs.fail() || !(ofs.is_open()))
+		return false;
+	CBitWriter writer(ofs);
+	writeTree(writer, codes, 0, codes.size(), 0);
+
+	ifs.clear();
+	ifs.seekg(0);
+	CUtf8Reader reader(ifs);
+	uint32_t key, size;
+	uint64_t written = 0, text_size = 0;
+	vector<uint8_t> index;
+	for (; written < symbol_count && reader.next(key, size); written++)
+	{
+		if (written % CHUNK_SIZE == 0)
+		{
+			appendUint64(index, writer.position());
+			appendUint64(index, text_size);
+			if (symbol_count - written >= CHUNK_SIZE)
+				writer.writeBits(1, 1);
+			else
+				writer.writeBits(symbol_count - written, 13);
+		}
+
+		const TCode *symbol = &ascii_codes[key & 0x7F];
+		if (size > 1)
+		{
+			unordered_map<uint32_t, TCode>::const_iterator it = counts.find(key);
+			symbol = it != counts.end() ? &it->second : nullptr;
+		}
+		if (!symbol || !symbol->c_Size)
+			break;
+		writer.writeBits(symbol->c_Code, symbol->c_Length);
+		text_size += size;
+	}
+	if (symbol_count % CHUNK_SIZE == 0)
+	{
+		appendUint64(index, writer.position());
+		appendUint64(index, text_size);
+		writer.writeBits(0, 13);
+	}
+
+	// the file may have changed between the passes
+	bool written_all = written == symbol_count && !reader.next(key, size) && !reader.invalid() && writer.finish();
+	if (written_all && chunk_index)
+	{
+		appendUint64(index, index.size() / 16);
+		appendUint64(index, text_size);
+		index.insert(index.end(), CHUNK_INDEX_MAGIC, CHUNK_INDEX_MAGIC + 8);
+		written_all = bool(ofs.write(reinterpret_cast<const char *>(index.data()), index.size()));
+	}
+	if (!written_all)
 	{
-		deleteTree(tree);
-		ifs.close();
 		ofs.close();
 		remove(outFileName);
 		return false;
 	}
 	return true;
 }
-
-bool compressFile ( const char * inFileName, const char * outFileName )
-{
-  // keep this dummy implementation (no bonus) or implement the compression (bonus)
-  return false;
-}
 #ifndef __PROGTEST__
 bool identicalFiles ( const char * fileName1, const char * fileName2 )
 {
-	ifstream file1(fileName1), file2(fileName2);
+	ifstream file1(fileName1, ios::binary), file2(fileName2, ios::binary);
 	if (file1.fail() || !(file1.is_open()) || file2.fail() || !(file2.is_open()))
-	{
-		file1.close();
-		file2.close();
 		return false;
+
+	istreambuf_iterator<char> it1(file1), it2(file2), end;
+	for (; it1 != end && it2 != end; ++it1, ++it2)
+		if (*it1 != *it2)
+			return false;
+	return it1 == end && it2 == end;
+}
+
+bool writeFile ( const char * fileName, const string & data )
+{
+	ofstream ofs(fileName, ios::binary);
+	return ofs.write(data.data(), data.size()) && ofs.good();
+}
+
+string readFile ( const char * fileName )
+{
+	ifstream ifs(fileName, ios::binary);
+	return string(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+}
+
+bool fileExists ( const char * fileName )
+{
+	return ifstream(fileName).is_open();
+}
+
+// compresses text, decompresses it again and compares it with the text
+bool roundTrip ( const string & text, bool chunk_index = false )
+{
+	return writeFile("tempfile0", text) && compressFile("tempfile0", "tempfile2", chunk_index)
+		&& decompressFile("tempfile2", "tempfile") && identicalFiles("tempfile0", "tempfile");
+}
+
+#ifdef BENCHMARK
+void appendUtf8(vector<uint8_t> &bytes, uint32_t code_point)
+{
+	if (code_point < 0x80)
+		bytes.push_back(code_point);
+	else if (code_point < 0x800)
+	{
+		bytes.push_back(0xC0 | (code_point >> 6));
+		bytes.push_back(0x80 | (code_point & 0x3F));
+	}
+	else if (code_point < 0x10000)
+	{
+		bytes.push_back(0xE0 | (code_point >> 12));
+		bytes.push_back(0x80 | ((code_point >> 6) & 0x3F));
+		bytes.push_back(0x80 | (code_point & 0x3F));
+	}
+	else
+	{
+		bytes.push_back(0xF0 | (code_point >> 18));
+		bytes.push_back(0x80 | ((code_point >> 12) & 0x3F));
+		bytes.push_back(0x80 | ((code_point >> 6) & 0x3F));
+		bytes.push_back(0x80 | (code_point & 0x3F));
 	}
+}
+
+// Writes a compressed file coded with a fixed tree, a chain of leaves with the codes 0, 10, 110, ... ending in
+// a complete subtree, so the codes are 1 to 15 bits long. A symbol is a subtree leaf with the probability long_share.
+// Returns the size of the text the file decompresses to.
+size_t writeBenchmarkFile(const char *fileName, double long_share, size_t symbol_count)
+{
+	const uint32_t CHAIN_LEAVES = 8, BALANCED_BITS = 7;
+	const uint32_t chain[CHAIN_LEAVES] = {' ', 'e', 'o', 'a', 0xED, 't', 0x159, 0x1F600};
+	vector<vector<uint8_t>> symbols(CHAIN_LEAVES + (1 << BALANCED_BITS));
+	for (uint32_t i = 0; i < CHAIN_LEAVES; i++)
+		appendUtf8(symbols[i], chain[i]);
+	for (uint32_t j = 0; j < (1u << BALANCED_BITS); j++)
+		appendUtf8(symbols[CHAIN_LEAVES + j], j < 26 ? 'A' + j : j < 36 ? '0' + j - 26 : j < 100 ? 0x100 + j - 36 : 0x4E00 + j - 100);
 
-	while ((!file1.eof()) && (!file2.eof()))
+	vector<uint8_t> out;
+	uint32_t acc = 0, count = 0;
+	auto put = [&](uint32_t value, uint32_t bits)
 	{
-		string line1, line2;
-		getline(file1, line1);
-		getline(file2, line2);
-		if (line1 != line2)
+		for (uint32_t i = bits; i-- > 0;)
 		{
-			file1.close();
-			file2.close();
-			return false;
+			acc = (acc << 1) | ((value >> i) & 1);
+			if (++count == 8)
+			{
+				out.push_back(acc);
+				acc = count = 0;
+			}
 		}
-		file1.close();
-		file2.close();
+	};
+	auto putLeaf = [&](const vector<uint8_t> &symbol)
+	{
+		put(1, 1);
+		for (size_t i = 0; i < symbol.size(); i++)
+			put(symbol[i], 8);
+	};
+	function<void(uint32_t, uint32_t)> putSubtree = [&](uint32_t depth, uint32_t first)
+	{
+		if (depth == BALANCED_BITS)
+			return putLeaf(symbols[CHAIN_LEAVES + first]);
+		put(0, 1);
+		putSubtree(depth + 1, first);
+		putSubtree(depth + 1, first + (1 << (BALANCED_BITS - depth - 1)));
+	};
+
+	for (uint32_t i = 0; i < CHAIN_LEAVES; i++)
+	{
+		put(0, 1);
+		putLeaf(symbols[i]);
 	}
+	putSubtree(0, 0);
 
-	return true;
+	mt19937 rng(47);
+	size_t text_size = 0;
+	for (size_t i = 0; i < symbol_count; i++)
+	{
+		if (i % CHUNK_SIZE == 0)
+			put(1, 1);
+
+		uint32_t symbol = 0;
+		if (rng() < long_share * rng.max())
+		{
+			symbol = rng() % (1 << BALANCED_BITS);
+			put((((1 << CHAIN_LEAVES) - 1) << BALANCED_BITS) | symbol, CHAIN_LEAVES + BALANCED_BITS);
+			symbol += CHAIN_LEAVES;
+		}
+		else
+		{
+			while (symbol < CHAIN_LEAVES - 1 && (rng() & 1))
+				symbol++;
+			put(((1 << symbol) - 1) << 1, symbol + 1);
+		}
+		text_size += symbols[symbol].size();
+	}
+	put(0, 1);
+	put(symbol_count % CHUNK_SIZE, 12);
+	put(0, 7);
+
+	ofstream ofs(fileName, ios::binary);
+	ofs.write(reinterpret_cast<const char *>(out.data()), out.size());
+	return text_size;
+}
+
+void benchmarkDecompression()
+{
+	const size_t symbol_count = 8 << 20;
+	const pair<const char *, double> inputs[] = {{"mostly short codes", 0.05}, {"mostly long codes", 0.6}};
+
+	for (const pair<const char *, double> &input : inputs)
+	{
+		size_t text_size = writeBenchmarkFile("benchmark.huf", input.second, symbol_count);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		bool done = decompressFile("benchmark.huf", "benchmark.out");
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+		cout << "decompress " << text_size / 1e6 << " MB, " << input.first << ": " << text_size / 1e6 / elapsed.count()
+		     << " MB/s" << (done ? "" : " (failed)") << endl;
+		remove("benchmark.huf");
+		remove("benchmark.out");
+	}
+}
+
+// Writes text of words made of Czech, Greek and Chinese syllables, the words drawn with a skewed distribution.
+size_t writeBenchmarkText(const char *fileName, size_t text_size)
+{
+	const char *syllables[] = {"ko", "lo", "to", "na", "pra", "ha", "st", "je", "mo", "ve", "č", "ře", "ši", "ná", "vý",
+		"ů", "ní", "ží", "mě", "dě", "ťo", "ň", "λό", "γος", "水", "火"};
+	const size_t syllable_count = sizeof(syllables) / sizeof(syllables[0]), word_count = 5000;
+	mt19937 rng(48);
+
+	vector<string> words(word_count);
+	for (string &word : words)
+		for (uint32_t i = 1 + rng() % 4; i > 0; i--)
+			word += syllables[rng() % syllable_count];
+
+	string text;
+	while (text.size() < text_size)
+	{
+		double u = rng() / double(rng.max());
+		text += words[size_t(u * u * u * (word_count - 1))];
+		uint32_t separator = rng() % 16;
+		text += separator == 0 ? ".\n" : separator == 1 ? ", " : " ";
+	}
+
+	ofstream ofs(fileName, ios::binary);
+	ofs.write(text.data(), text.size());
+	return text.size();
 }
 
+void benchmarkCompression()
+{
+	size_t text_size = writeBenchmarkText("benchmark.txt", 16 << 20);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	bool compressed = compressFile("benchmark.txt", "benchmark.huf");
+	chrono::duration<double> compress_time = chrono::steady_clock::now() - start;
+
+	start = chrono::steady_clock::now();
+	bool decompressed = decompressFile("benchmark.huf", "benchmark.out");
+	chrono::duration<double> decompress_time = chrono::steady_clock::now() - start;
+
+	ifstream text("benchmark.txt", ios::binary), compressed_text("benchmark.huf", ios::binary), output("benchmark.out", ios::binary);
+	stringstream text_data, output_data;
+	text_data << text.rdbuf();
+	output_data << output.rdbuf();
+	compressed_text.seekg(0, ios::end);
+	bool round_trip = compressed && decompressed && text_data.str() == output_data.str();
+
+	cout << "compress " << text_size / 1e6 << " MB of text: " << text_size / 1e6 / compress_time.count() << " MB/s, "
+	     << 100.0 * compressed_text.tellg() / text_size << " % of the size" << endl;
+	cout << "decompress it: " << text_size / 1e6 / decompress_time.count() << " MB/s" << (round_trip ? "" : " (round trip failed)") << endl;
+
+	compressFile("benchmark.txt", "benchmark.huf", true);
+	const size_t thread_counts[] = {1, max(1u, thread::hardware_concurrency())};
+	for (size_t threads : thread_counts)
+	{
+		g_decompress_threads = threads;
+		start = chrono::steady_clock::now();
+		decompressed = decompressFile("benchmark.huf", "benchmark.out");
+		decompress_time = chrono::steady_clock::now() - start;
+		cout << "decompress it with a chunk index on " << threads << " threads: " << text_size / 1e6 / decompress_time.count()
+		     << " MB/s" << (decompressed ? "" : " (failed)") << endl;
+	}
+	g_decompress_threads = 0;
+	remove("benchmark.txt");
+	remove("benchmark.huf");
+	remove("benchmark.out");
+}
+#endif /* BENCHMARK */
+
 int main ( void )
 {
+	remove("tempfile2");
+	assert(writeFile("tempfile0", ""));
+	assert(!compressFile("tempfile0", "tempfile2"));
+	assert(!fileExists("tempfile2"));
+
+	assert(roundTrip("Kolotoc"));
+	assert(roundTrip(string(100, 'a')));
+	assert(roundTrip(string(4096, 'a')));
+	string text;
+	for (int i = 0; i < 4096; i++)
+		text += i % 3 ? "a" : i % 5 ? "\u0159" : "\U0001F600";
+	assert(roundTrip(text));
+	assert(roundTrip(text + text));
+	assert(roundTrip("P\u0159\u00edli\u0161 \u017elu\u0165ou\u010dk\u00fd k\u016f\u0148 \u00fap\u011bl \u010f\u00e1belsk\u00e9 \u00f3dy, \u03bb\u03cc\u03b3\u03bf\u03c2 \u6c34\u706b"));
+	assert(writeFile("tempfile", "abc"));
+	assert(!identicalFiles("tempfile0", "tempfile"));
+
+	g_decompress_threads = 3;
+	string chunks;
+	for (int i = 0; i < 3 * 4096 + 100; i++)
+		chunks += i % 7 ? string(1, 'a' + i % 13) : i % 2 ? "\u0159" : "\U0001F600";
+	assert(roundTrip(chunks, true));
+	assert(roundTrip(chunks));
+	assert(roundTrip(text + text, true));
+	assert(writeFile("tempfile0", chunks) && compressFile("tempfile0", "tempfile2", true));
+	string compressed = readFile("tempfile2");
+	size_t entries = compressed.size() - CHUNK_INDEX_FOOTER - 4 * 16;
+	assert(convertUint64((const uint8_t *) compressed.data() + compressed.size() - CHUNK_INDEX_FOOTER) == 4);
+	// the second chunk starting one byte later in the text has to be rejected
+	compressed[entries + 16 + 8]++;
+	assert(writeFile("tempfile2", compressed));
+	assert(!decompressFile("tempfile2", "tempfile"));
+	assert(!fileExists("tempfile"));
+	g_decompress_threads = 0;
+
+	remove("tempfile2");
+	assert(writeFile("tempfile0", "ab\xC3"));
+	assert(!compressFile("tempfile0", "tempfile2"));
+	assert(writeFile("tempfile0", "ab\x80" "cd"));
+	assert(!compressFile("tempfile0", "tempfile2"));
+	assert(writeFile("tempfile0", "ab\xC5x"));
+	assert(!compressFile("tempfile0", "tempfile2"));
+	assert(!fileExists("tempfile2"));
+	assert(writeFile("tempfile2", string(1 << 20, '\0')));
+	assert(!decompressFile("tempfile2", "tempfile"));
+	assert(!fileExists("tempfile"));
+	remove("tempfile2");
+
 	assert(decompressFile("tests/test0.huf", "tempfile"));
 	assert(identicalFiles("tests/test0.orig", "tempfile"));
 
@@ -418,6 +1156,37 @@ int main ( void )
 	assert(decompressFile("tests/extra9.huf", "tempfile"));
 	assert(identicalFiles("tests/extra9.orig", "tempfile"));
 
+	assert(compressFile("tests/test0.orig", "tempfile2"));
+	assert(decompressFile("tempfile2", "tempfile"));
+	assert(identicalFiles("tests/test0.orig", "tempfile"));
+
+	assert(compressFile("tests/test1.orig", "tempfile2"));
+	assert(decompressFile("tempfile2", "tempfile"));
+	assert(identicalFiles("tests/test1.orig", "tempfile"));
+
+	assert(compressFile("tests/test2.orig", "tempfile2"));
+	assert(decompressFile("tempfile2", "tempfile"));
+	assert(identicalFiles("tests/test2.orig", "tempfile"));
+
+	assert(compressFile("tests/test3.orig", "tempfile2"));
+	assert(decompressFile("tempfile2", "tempfile"));
+	assert(identicalFiles("tests/test3.orig", "tempfile"));
+
+	assert(compressFile("tests/test4.orig", "tempfile2"));
+	assert(decompressFile("tempfile2", "tempfile"));
+	assert(identicalFiles("tests/test4.orig", "tempfile"));
+
+	assert(compressFile("tests/test4.orig", "tempfile2", true));
+	assert(decompressFile("tempfile2", "tempfile"));
+	assert(identicalFiles("tests/test4.orig", "tempfile"));
+
+	assert(!compressFile("tests/nonexistent.orig", "tempfile2"));
+
+#ifdef BENCHMARK
+	benchmarkDecompression();
+	benchmarkCompression();
+#endif /* BENCHMARK */
+
 	return 0;
 }
 #endif /* __PROGTEST__ */